@@ -0,0 +1,82 @@
+#include "BPTextDumpCommandlet.h"
+#include "BPTextDumpModule.h"
+#include "BPTextDumpSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Modules/ModuleManager.h"
+#include "HAL/PlatformTime.h"
+
+UBPTextDumpCommandlet::UBPTextDumpCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+    ShowErrorCount = true;
+}
+
+int32 UBPTextDumpCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens, Switches;
+    TMap<FString, FString> ParamMap;
+    ParseCommandLine(*Params, Tokens, Switches, ParamMap);
+
+    // 설정 기본값을 먼저 넣고, 명령줄 인자가 뒤에서 덮어씀 (UI_DumpAll과 동일한 기본값)
+    TArray<FString> Args;
+    if (const UBPTextDumpSettings* S = GetDefault<UBPTextDumpSettings>())
+    {
+        if (!S->DefaultRootPath.IsEmpty()) Args.Add(TEXT("Root=") + S->DefaultRootPath);
+        if (!S->DefaultOutDir.IsEmpty())   Args.Add(TEXT("Out=") + S->DefaultOutDir);
+    }
+
+    // Key=Value는 토큰(Root=/Game)이든 스위치(-Root=/Game)든 받음
+    FString Mode = TEXT("DumpAll");
+    auto AddArg = [&](const FString& A)
+        {
+            if (A.StartsWith(TEXT("Mode="), ESearchCase::IgnoreCase)) Mode = A.RightChop(5);
+            else if (A.StartsWith(TEXT("run="), ESearchCase::IgnoreCase)) {}
+            else Args.Add(A);
+        };
+    for (const FString& T : Tokens)   AddArg(T);
+    for (const FString& Sw : Switches) AddArg(Sw);
+
+    const bool bDumpAll = Mode.Equals(TEXT("DumpAll"), ESearchCase::IgnoreCase) || Mode.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+    const bool bProjectRefs = Mode.Equals(TEXT("ProjectRefs"), ESearchCase::IgnoreCase) || Mode.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+    const bool bMergeShards = Mode.Equals(TEXT("MergeShards"), ESearchCase::IgnoreCase);
+    if (!bDumpAll && !bProjectRefs && !bMergeShards)
+    {
+        UE_LOG(LogTemp, Error, TEXT("BPTextDump commandlet: unknown Mode=%s (DumpAll | ProjectRefs | All | MergeShards)"), *Mode);
+        return 2;
+    }
+
+    FBPTextDumpModule& Module = FModuleManager::LoadModuleChecked<FBPTextDumpModule>(TEXT("BPTextDump"));
+    auto ExitCode = [](EBPTextDumpResult R)
+        {
+            return R == EBPTextDumpResult::Ok ? 0 : R == EBPTextDumpResult::BadArguments ? 2 : 1;
+        };
+
+    // 샤드 결과 합치기는 레지스트리/에셋이 필요 없음
+    if (bMergeShards)
+        return ExitCode(Module.RunMergeShards(Args));
+
+    // 커맨드렛은 에디터처럼 백그라운드 스캔이 없으므로 레지스트리를 먼저 채움
+    FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+    const double T0 = FPlatformTime::Seconds();
+    ARM.Get().SearchAllAssets(/*bSynchronousSearch*/ true);
+    UE_LOG(LogTemp, Display, TEXT("BPTextDump commandlet: asset registry scan %.2fs"), FPlatformTime::Seconds() - T0);
+
+    // 인자 오류는 즉시 2. 그 외에는 단계를 모두 돌리고 실패가 있으면 1
+    int32 Code = 0;
+    if (bDumpAll)
+    {
+        Code = ExitCode(Module.RunDumpAll(Args));
+        if (Code == 2) return Code;
+    }
+    if (bProjectRefs)
+    {
+        Code = FMath::Max(Code, ExitCode(Module.RunProjectRefs(Args)));
+        if (Code == 2) return Code;
+    }
+
+    if (Code != 0) UE_LOG(LogTemp, Error, TEXT("BPTextDump commandlet: finished with failures"));
+    return Code;
+}
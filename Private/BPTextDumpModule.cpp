@@ -1,6 +1,21 @@
 ﻿#include "BPTextDumpModule.h" // MUST be first include
 #include "BTD_Anchors.h"
 #include "BTD_Hash.h"
+#include "BTD_Pipeline.h"
+#include "BTD_GraphIR.h"
+#include "BTD_Output.h"
+#include "BTD_Utf8.h"
+#include "BTD_Prefetch.h"
+#include "BTD_Memory.h"
+#include "BTD_RefGraph.h"
+#include "BTD_GraphStore.h"
+#include "BTD_NDJson.h"
+#include "BTD_Facts.h"
+#include "BTD_FactStore.h"
+#include "BTD_Lint.h"
+#include "BTD_FunctionClass.h"
+#include "BTD_Symbols.h"
+#include "BTD_ClassHierarchy.h"
 #include "K2Node_Knot.h"          // 리루트(리라우트) 핀 추적
 #include "EdGraph/EdGraphPin.h"
 
@@ -27,6 +42,10 @@
 #include "HAL/FileManager.h"
 #include "HAL/IConsoleManager.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "IO/IoHash.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
@@ -49,6 +68,8 @@
 #include "Components/PanelSlot.h"
 #include "Components/CanvasPanelSlot.h"
 
+#include <atomic>
+
 
 
 //#include "Kismet2/BlueprintEditorUtils.h" // optional (for extra helpers)
@@ -56,31 +77,47 @@
 IMPLEMENT_MODULE(FBPTextDumpModule, BPTextDump);
 
 // 기존 파일 안의 정적 헬퍼들을 앞에서 참조할 수 있도록 프로토타입 추가
-static bool WriteJsonToFile(const FJsonObject& Root, const FString& OutPath);
-static bool WriteTextToFile(const FString& Text, const FString& OutPath);
+// 산출물 JSON은 DOM(FJsonObject) 없이 이 작성기로 UTF-8 빌더에 바로 직렬화한다 (condensed)
+using FJsonStreamWriter = TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>;
+
+static TSharedRef<FJsonStreamWriter> MakeJsonStreamWriter(BTD::FUtf8Builder& Out)
+{
+    return TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Out);
+}
+
+static bool WriteJsonToFile(const TSharedRef<FJsonObject>& Root, const FString& OutPath);
+static bool WriteUtf8ToFile(BTD::FUtf8Builder& Bytes, const FString& OutPath);
+static bool WriteUtf8ToFile(BTD::FUtf8Builder& Bytes, const FString& OutPath, BTD::FHashLedger& Ledger);
+static void BeginTextArtifact(BTD::FUtf8Builder& Out, const TCHAR* Ext);
 static void AddFrontMatter(TSharedRef<FJsonObject> J);
+static void WriteFrontMatter(FJsonStreamWriter& JW);
+
+// bpcatalog.json slices 항목 1개 (type은 항상 "flow")
+struct FFlowSlice
+{
+    FString Id;
+    FString Range;
+    FString Source;
+};
 
 // 우리가 쓰는 슬라이스 빌더 프로토타입
-static void BuildSlicesForGraph(UEdGraph* Graph,
-    const TArray<UEdGraphNode*>& SortedNodes,
-    TArray<TSharedPtr<FJsonValue>>& Out);
+static void BuildSlicesForGraph(const BTD::FGraphIR& G,
+    TArray<FFlowSlice>& Out);
 
+struct FBPDumpJob;
+struct FDefUseData;
 static void BuildAndWriteSummaryForBP(
-    UBlueprint* BP,
-    const TArray<TSharedPtr<FJsonValue>>& Slices,
+    const FBPDumpJob& Job,
+    const TArray<FFlowSlice>& Slices,
+    const FDefUseData& DefUse,
     const FString& MetaFilePath,
     const TArray<FString>& FlowJsonPaths,
-    const FString& OutRoot);
-
-static bool IsDataInputPin(const UEdGraphPin* P);
-static FString GetCallTargetObjectVarName(const UK2Node_CallFunction * Call);
-static FString GetObjectVarNameFromInputPin(UEdGraphPin* Pin);
-static UEdGraphPin * FindInputPinByName(UEdGraphNode * N, const TCHAR * NameA, const TCHAR * NameB);
+    BTD::FHashLedger& Ledger);
 
 static TSharedPtr<FJsonObject> LoadJsonObject(const FString & Path)
  {
     FString JsonStr;
-    if (!FFileHelper::LoadFileToString(JsonStr, *Path)) return nullptr;
+    if (!BTD::LoadArtifactToString(Path, JsonStr)) return nullptr; // 큐에 남은 기록도 보임
     TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(JsonStr);
     TSharedPtr<FJsonObject> Obj;
     FJsonSerializer::Deserialize(R, Obj);
@@ -114,27 +151,29 @@ static FString ToAssetKeyFromObjectPath(const FString& ObjPath)
     return ToAssetKeyFromClassPath(ObjPath);
 }
 
-static void AddRef(TMap<FString, TSet<FString>>& G, const FString& From, const FString& To)
+// BP 하나의 프로젝트 레퍼런스 후보 (덤프 중 메모리에서 모으고 <BP>.bprefs.json으로 기록).
+// Keys = 이미 자산 키("/Game/A/B", "/Script/Engine"), Names = 이름 인덱스(NameToId)로 해석할 이름
+struct FAssetRefSet
 {
-    if (From.IsEmpty() || To.IsEmpty() || From == To) return;
-    G.FindOrAdd(From).Add(To);
-}
+    TSet<FString> Keys;
+    TSet<FString> Names;
 
-static void ReadNDJSONLines(const FString& Path, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Fn)
-{
-    FString Body;
-    if (!FFileHelper::LoadFileToString(Body, *Path)) return;
-    TArray<FString> Lines;
-    Body.ParseIntoArrayLines(Lines);
-    for (const FString& L : Lines)
+    void AddPath(const FString& Path)
     {
-        if (L.TrimStartAndEnd().IsEmpty()) continue;
-        TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(L);
-        TSharedPtr<FJsonObject> O;
-        if (FJsonSerializer::Deserialize(R, O) && O.IsValid())
-            Fn(O);
+        const FString Key = ToAssetKeyFromObjectPath(Path);
+        if (!Key.IsEmpty()) Keys.Add(Key);
     }
-}
+
+    // fact의 o 값: 경로면 그대로, "Class.Func"면 Class, 그 외(위젯/BP 변수명 등)는 순수 이름
+    void AddFactObject(const FString& Obj)
+    {
+        if (Obj.IsEmpty()) return;
+        if (Obj.StartsWith(TEXT("/Game/")) || Obj.StartsWith(TEXT("/Script/"))) { AddPath(Obj); return; }
+        int32 Dot = INDEX_NONE;
+        if (Obj.FindChar(TCHAR('.'), Dot)) Names.Add(Obj.Left(Dot));
+        else                               Names.Add(Obj);
+    }
+};
 
 
 // ============================================================
@@ -152,45 +191,39 @@ static FString GetSelfClassPath(UBlueprint* BP)
 static FString ResolveVarDefinedIn(UBlueprint* BP, const FName VarName)
 {
     if (!BP || VarName.IsNone()) return TEXT("");
-    // 부모 체인을 따라 올라가며 같은 이름의 FProperty가 존재하면 그 클래스 경로를 반환
-    for (UClass* C = BP->ParentClass; C; C = C->GetSuperClass())
-    {
-        if (FindFProperty<FProperty>(C, VarName))
-        {
-            return C->GetPathName();
-        }
-    }
+    // 부모 체인에 같은 이름의 FProperty가 있으면 부모 클래스 경로 (계층 캐시, 덤프 명령 동안 공유)
+    FString Path = BTD::FClassHierarchyCache::Get().FindMemberClassPath(BP->ParentClass, VarName, BTD::EClassMember::Property);
     // 없으면 현재 BP가 원 정의
-    return GetSelfClassPath(BP);
+    return Path.IsEmpty() ? GetSelfClassPath(BP) : Path;
 }
 
 static FString ResolveFunctionDefinedIn(UBlueprint* BP, const FName FuncName)
 {
     if (!BP || FuncName.IsNone()) return TEXT("");
     // 1) 인터페이스에 동일 시그니처 함수가 있으면 인터페이스 경로
+    BTD::FClassHierarchyCache& Cache = BTD::FClassHierarchyCache::Get();
     for (const FBPInterfaceDescription& D : BP->ImplementedInterfaces)
     {
-        if (D.Interface && D.Interface->FindFunctionByName(FuncName))
+        if (D.Interface && !Cache.FindMemberClassPath(D.Interface, FuncName, BTD::EClassMember::Function).IsEmpty())
         {
             return D.Interface->GetPathName();
         }
     }
-    // 2) 부모 체인에서 찾히면 그 클래스 경로
-    for (UClass* C = BP->ParentClass; C; C = C->GetSuperClass())
-    {
-        if (C->FindFunctionByName(FuncName))
-        {
-            return C->GetPathName();
-        }
-    }
+    // 2) 부모 체인에서 찾히면 부모 클래스 경로
+    FString Path = Cache.FindMemberClassPath(BP->ParentClass, FuncName, BTD::EClassMember::Function);
     // 3) 그 외는 본인
-    return GetSelfClassPath(BP);
+    return Path.IsEmpty() ? GetSelfClassPath(BP) : Path;
 }
 
 
 // ---------------- helpers ----------------
-static FString JsonLine_Fact(const FString& S, const FString& P, const FString& O, const TArray<FString>& Ev)
+// fact 1개를 NDJSON 한 줄로 Out에 바로 직렬화 (줄바꿈은 호출 측)
+static void WriteFactLine(BTD::FUtf8Builder& Out, const BTD::FFactTable& Facts, const BTD::FFactTable::FFact& F)
 {
+    const FString& S = Facts.Str(F.S);
+    const FString& P = Facts.Str(F.P);
+    const FString& O = Facts.Str(F.O);
+
     // Try to emit numeric JSON for 'o' when it looks like a number
     auto LooksNumeric = [](const FString& X)->bool {
         if (X.IsEmpty()) return false;
@@ -204,136 +237,105 @@ static FString JsonLine_Fact(const FString& S, const FString& P, const FString&
         }
         return bDigit;
         };
-    TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
-    Obj->SetStringField(TEXT("s"), S);
-    Obj->SetStringField(TEXT("p"), P);
+    // 모양이 고정이라 TJsonWriter 없이 바로 씀 (BTD::ParseFactLineFast가 읽는 모양과 같음)
+    Out += TEXT("{\"s\":");
+    Out.AppendJsonString(S);
+    Out += TEXT(",\"p\":");
+    Out.AppendJsonString(P);
+    Out += TEXT(",\"o\":");
     if (LooksNumeric(O))
     {
-        Obj->SetNumberField(TEXT("o"), FCString::Atod(*O));
+        Out.Appendf(TEXT("%.17g"), FCString::Atod(*O)); // TJsonWriter의 double 출력과 같은 형식
     }
     else
     {
-        Obj->SetStringField(TEXT("o"), O);
-    }
-    {
-        TArray<TSharedPtr<FJsonValue>> Arr;
-        for (const FString& A : Ev) Arr.Add(MakeShared<FJsonValueString>(A));
-        Obj->SetArrayField(TEXT("ev"), Arr);
+        Out.AppendJsonString(O);
     }
-    FString Out;
-    auto W = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
-    FJsonSerializer::Serialize(Obj, W);
-    return Out;
-}
-
-static FString PinDefaultOrText(const UEdGraphPin* P, const TCHAR* NameA = nullptr, const TCHAR* NameB = nullptr)
-{
-    if (!P) return TEXT("");
-    if (NameA || NameB)
+    TArray<int32, TInlineAllocator<8>> Ev;
+    Facts.SortedEvidence(F, Ev);
+    Out += TEXT(",\"ev\":[");
+    for (int32 i = 0; i < Ev.Num(); ++i)
     {
-        const FString N = P->PinName.ToString();
-        if (NameA && N.Equals(NameA, ESearchCase::IgnoreCase)) { /* ok */ }
-        else if (NameB && N.Equals(NameB, ESearchCase::IgnoreCase)) { /* ok */ }
-        else return TEXT("");
+        if (i > 0) Out += TEXT(",");
+        Out.AppendJsonString(Facts.Str(Ev[i]));
     }
-    if (!P->DefaultTextValue.IsEmpty()) return P->DefaultTextValue.ToString();
-    if (!P->DefaultValue.IsEmpty())     return P->DefaultValue;
-    return TEXT("");
+    Out += TEXT("]}");
 }
 
-static UEdGraphPin* FindInputPinByName(UEdGraphNode* N, const TCHAR* NameA, const TCHAR* NameB = nullptr)
+// fact 테이블 → NDJSON (한 줄에 fact 하나, 처음 나온 순서)
+static void WriteFactsNDJson(BTD::FUtf8Builder& Out, const BTD::FFactTable& Facts)
 {
-    if (!N) return nullptr;
-    for (UEdGraphPin* P : N->Pins)
+    for (int32 i = 0; i < Facts.Num(); ++i)
     {
-        if (!P || P->Direction != EGPD_Input) continue;
-        const FString Nm = P->PinName.ToString();
-        if (Nm.Equals(NameA, ESearchCase::IgnoreCase) || (NameB && Nm.Equals(NameB, ESearchCase::IgnoreCase)))
-            return P;
+        if (i > 0) Out += TEXT("\n");
+        WriteFactLine(Out, Facts, Facts[i]);
     }
-    return nullptr;
 }
 
-static void BuildFactsForBP(
-    UBlueprint* BP,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
-    const FString& OutRoot)
+// 워커 스레드 가능: 그래프 IR을 훑어 fact를 Out 테이블에 모음 (같은 s/p/o는 근거만 합침)
+// OutRefs가 있으면 각 fact의 o 값을 레퍼런스 후보로도 모음
+static void CollectFactsForBP(
+    const FString& SelfBP,
+    const TArray<BTD::FGraphIR>& Graphs,
+    BTD::FFactTable& Out,
+    FAssetRefSet* OutRefs = nullptr)
 {
-    if (!BP) return;
-    TArray<FString> Lines;
-
-    auto Emit = [&](const FString& S, const FString& P, const FString& O, TArray<FString> Ev)
+    auto Emit = [&](const FString& S, const FString& P, const FString& O, std::initializer_list<FString> Ev)
         {
-            {
-                TSet<FString> Dedup(Ev);
-                Ev = Dedup.Array();
-                Ev.Sort();
-            }
-             Lines.Add(JsonLine_Fact(S, P, O, Ev));
+            Out.Add(S, P, O, Ev);
         };
 
-    const FString SelfBP = BP->GetName();
-
-    for (const auto& KVP : SortedByGraph)
+    for (const BTD::FGraphIR& G : Graphs)
     {
-        const TArray<UEdGraphNode*>& Nodes = KVP.Value;
-        // Precompute node anchors
-        TMap<const UEdGraphNode*, FString> AKey;
-        for (UEdGraphNode* N : Nodes)
-            if (IsValid(N)) AKey.Add(N, TEXT("@") + BTD::AnchorForNode(N));
-
-        for (UEdGraphNode* N : Nodes)
+        for (const int32 N : G.Sorted)
         {
-            if (!IsValid(N)) continue;
-            const FString A = AKey[N];
+            const FString& A = G.AnchorKey(N);
+            const BTD::ENodeKind Kind = G.NodeKind[N];
 
             // 1) CallFunction-based heuristics
-            if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(N))
+            if (Kind == BTD::ENodeKind::CallFunction)
             {
-                const UFunction* Fn = Call->GetTargetFunction();
-                const FString FnName = Fn ? Fn->GetName() : TEXT("");
-                const FString OwnerPath = Fn && Fn->GetOwnerClass() ? Fn->GetOwnerClass()->GetPathName() : TEXT("");
-                const FString OwnerSimple = Fn && Fn->GetOwnerClass() ? Fn->GetOwnerClass()->GetName() : TEXT("UnknownClass");
+                const FString& FnName = G.Str(G.NodeFunc[N]);
+                const FString& OwnerPath = G.Str(G.NodeFuncOwnerPath[N]);
+                const FString OwnerSimple = G.NodeFuncOwnerName[N] ? G.Str(G.NodeFuncOwnerName[N]) : FString(TEXT("UnknownClass"));
                 const FString QualifiedFn = OwnerSimple + TEXT(".") + FnName;
-                
-                                    // Subject: 실제 Target/Self 변수명 우선, 없으면 BP 이름
-                    FString Subject = GetCallTargetObjectVarName(Call);
+
+                // Subject: 실제 Target/Self 변수명 우선, 없으면 BP 이름
+                FString Subject = G.Str(G.CallTargetObjectVarName(N));
                 if (Subject.IsEmpty()) Subject = SelfBP;
 
-                    bool bEmittedSpecific = false;
-                
-                    if (FnName.Contains(TEXT("SetText")))
-                     {
-                    UEdGraphPin * TextPin = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("InText"), TEXT("Text"));
-                    FString Val = PinDefaultOrText(TextPin);
+                bool bEmittedSpecific = false;
+
+                if (G.IsFunc(N, BTD::FC_SetText))
+                {
+                    const int32 TextPin = G.FindInputPin(N, TEXT("InText"), TEXT("Text"));
+                    const FString Val = G.PinDefaultOrText(TextPin);
                     if (!Val.IsEmpty())
-                         {
+                    {
                         Emit(Subject, TEXT("text_set_to"), Val, { A });
-                        }
-                     else
-                         {
+                    }
+                    else
+                    {
                         Emit(Subject, TEXT("text_set_via"), QualifiedFn, { A });
-                        }
-                     bEmittedSpecific = true;
                     }
+                    bEmittedSpecific = true;
+                }
 
                 // 1.a) visibility_set_to (UMG)
-                if (FnName.Contains(TEXT("SetVisibility")))
+                if (G.IsFunc(N, BTD::FC_SetVisibility))
                 {
-                    UEdGraphPin* VisPin = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("InVisibility"), TEXT("In Visibility"));
+                    const int32 VisPin = G.FindInputPin(N, TEXT("InVisibility"), TEXT("In Visibility"));
                     FString VisVal;
-                    if (VisPin)
+                    if (VisPin != INDEX_NONE)
                     {
-                        if (!VisPin->LinkedTo.Num())
+                        if (!G.IsLinked(VisPin))
                         {
-                            VisVal = PinDefaultOrText(VisPin);
+                            VisVal = G.PinDefaultOrText(VisPin);
                         }
-                        else
+                        else if (G.Links(VisPin).Num() > 0)
                         {
                             // fallback: use linked node title
-                            if (UEdGraphPin* L = VisPin->LinkedTo[0])
-                                if (UEdGraphNode* LN = L->GetOwningNode())
-                                    VisVal = LN->GetNodeTitle(ENodeTitleType::ListView).ToString();
+                            VisVal = G.Str(G.NodeListTitle[G.PinNode[G.Links(VisPin)[0]]]);
                         }
                     }
                     if (VisVal.IsEmpty()) VisVal = TEXT("Unknown");
@@ -341,36 +343,31 @@ static void BuildFactsForBP(
                     bEmittedSpecific = true;
                 }
 
-                if (FnName.Contains(TEXT("SetIsEnabled")))
+                if (G.IsFunc(N, BTD::FC_SetIsEnabled))
                 {
-                    UEdGraphPin* PinE = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("bInIsEnabled"), TEXT("In Is Enabled"));
-                    FString V = PinDefaultOrText(PinE);
-                    if (V.IsEmpty() && PinE && PinE->LinkedTo.Num() == 0) V = TEXT("false");
+                    const int32 PinE = G.FindInputPin(N, TEXT("bInIsEnabled"), TEXT("In Is Enabled"));
+                    FString V = G.PinDefaultOrText(PinE);
+                    if (V.IsEmpty() && PinE != INDEX_NONE && !G.IsLinked(PinE)) V = TEXT("false");
                     if (!V.IsEmpty()) Emit(Subject, TEXT("enabled_set_to"), V, { A });
                     bEmittedSpecific = true;
                 }
 
                 // 1.d) adds_child_widget (PanelWidget::AddChild 계열)
-                if (FnName.StartsWith(TEXT("AddChild")))
+                if (G.IsFunc(N, BTD::FC_AddChild))
                 {
                     // child 후보 핀 이름들
-                    UEdGraphPin * ChildPin = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("Content"));
-                    if (!ChildPin) ChildPin = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("Child"));
-                    if (!ChildPin) ChildPin = FindInputPinByName(const_cast<UK2Node_CallFunction*>(Call), TEXT("InContent"));
-                    FString ChildName;
-                    if (ChildPin)
-                    {
-                        // 변수 추적해서 이름을 얻을 수 있으면 사용
-                        FString V = GetObjectVarNameFromInputPin(ChildPin);
-                        if (!V.IsEmpty()) ChildName = V;
-                    }
+                    int32 ChildPin = G.FindInputPin(N, TEXT("Content"));
+                    if (ChildPin == INDEX_NONE) ChildPin = G.FindInputPin(N, TEXT("Child"));
+                    if (ChildPin == INDEX_NONE) ChildPin = G.FindInputPin(N, TEXT("InContent"));
+                    // 변수 추적해서 이름을 얻을 수 있으면 사용
+                    FString ChildName = G.Str(G.ObjectVarNameFromInputPin(ChildPin));
                     if (ChildName.IsEmpty()) ChildName = TEXT("Widget");
                     Emit(Subject, TEXT("adds_child_widget"), ChildName, { A });
                     bEmittedSpecific = true;
                 }
 
                 // 1.e) clears_child_widgets
-                if (FnName.Contains(TEXT("ClearChildren")))
+                if (G.IsFunc(N, BTD::FC_ClearChildren))
                 {
                     Emit(Subject, TEXT("clears_child_widgets"), TEXT("all"), { A });
                     bEmittedSpecific = true;
@@ -378,31 +375,25 @@ static void BuildFactsForBP(
 
 
                 // 1.b) comparison: is_compared_to
-                auto IsCmp = [](const FString& Name)->bool {
-                    return Name.StartsWith(TEXT("EqualEqual")) || Name.StartsWith(TEXT("Greater")) || Name.StartsWith(TEXT("Less"));
-                    };
-                if (IsCmp(FnName))
+                if (G.IsFunc(N, BTD::FC_Compare))
                 {
                     // Find a variable on one input and a constant on the other
                     FString VarName, ConstStr;
-                    for (UEdGraphPin* In : N->Pins)
+                    for (int32 In = G.NodeFirstPin[N], E = In + G.NodeNumPins[N]; In < E; ++In)
                     {
-                        if (!IsDataInputPin(In)) continue;
-                        if (In->LinkedTo.Num() == 0)
+                        if (!G.IsDataInput(In)) continue;
+                        if (!G.IsLinked(In))
                         {
-                            const FString D = PinDefaultOrText(In);
+                            const FString D = G.PinDefaultOrText(In);
                             if (!D.IsEmpty()) ConstStr = D;
                         }
                         else
                         {
-                            for (UEdGraphPin* L : In->LinkedTo)
+                            for (const int32 L : G.Links(In))
                             {
-                                if (!L || !L->GetOwningNode()) continue;
-                                if (const UK2Node_VariableGet* Get = Cast<UK2Node_VariableGet>(L->GetOwningNode()))
-                                {
-                                    const FName V = Get->GetVarName();
-                                    if (!V.IsNone()) VarName = V.ToString();
-                                }
+                                const int32 LN = G.PinNode[L];
+                                if (G.NodeKind[LN] == BTD::ENodeKind::VariableGet && G.NodeVar[LN])
+                                    VarName = G.Str(G.NodeVar[LN]);
                             }
                         }
                     }
@@ -417,8 +408,7 @@ static void BuildFactsForBP(
                 if (!bEmittedSpecific && !OwnerPath.IsEmpty())
                 {
                     // exclude self-context call (best-effort)
-                    const bool bSelf = Call->FunctionReference.IsSelfContext();
-                    if (!bSelf)
+                    if (!G.HasFlag(N, BTD::NF_SelfContext))
                     {
                         Emit(Subject, TEXT("depends_on"), QualifiedFn, { A });
                     }
@@ -426,139 +416,101 @@ static void BuildFactsForBP(
             }
 
             // 2) VariableSet: is_acquired_via
-            if (const UK2Node_VariableSet* Set = Cast<UK2Node_VariableSet>(N))
+            if (Kind == BTD::ENodeKind::VariableSet && G.NodeVar[N])
             {
-                const FName TargetVar = Set->GetVarName();
-                FString VarName = TargetVar.IsNone() ? TEXT("") : TargetVar.ToString();
-                if (!VarName.IsEmpty())
+                const FString& VarName = G.Str(G.NodeVar[N]);
+                // Look at input data pins to detect common acquisition patterns
+                for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
                 {
-                    // Look at input data pins to detect common acquisition patterns
-                    for (UEdGraphPin* P : N->Pins)
+                    if (!G.IsDataInput(P)) continue;
+                    for (const int32 L : G.Links(P))
                     {
-                        if (!IsDataInputPin(P)) continue;
-                        for (UEdGraphPin* L : P->LinkedTo)
+                        const int32 CF = G.PinNode[L];
+                        if (G.NodeKind[CF] != BTD::ENodeKind::CallFunction) continue;
+                        if (!G.IsFunc(CF, BTD::FC_GetAllActorsOfClass)) continue;
+
+                        FString How = TEXT("GetAllActorsOfClass");
+                        // Check for downstream Array Get index 0 pattern
+                        int32 OutP = INDEX_NONE;
+                        for (int32 pp = G.NodeFirstPin[CF], PE = pp + G.NodeNumPins[CF]; pp < PE; ++pp)
+                            if (!G.IsInput(pp)) { OutP = pp; break; }
+                        if (OutP != INDEX_NONE)
                         {
-                            if (!L || !L->GetOwningNode()) continue;
-                            if (const UK2Node_CallFunction* CF = Cast<UK2Node_CallFunction>(L->GetOwningNode()))
+                            for (const int32 L2 : G.Links(OutP))
                             {
-                                const UFunction* F = CF->GetTargetFunction();
-                                const FString FnName = F ? F->GetName() : TEXT("");
-                                if (FnName.Contains(TEXT("GetAllActorsOfClass")))
+                                const int32 CF2 = G.PinNode[L2];
+                                if (!G.Str(G.NodeClass[CF2]).Contains(TEXT("K2Node_CallFunction"))) continue;
+                                if (G.NodeKind[CF2] == BTD::ENodeKind::CallFunction && G.IsFunc(CF2, BTD::FC_ArrayGet))
                                 {
-                                    FString How = TEXT("GetAllActorsOfClass");
-                                    // Check for downstream Array Get index 0 pattern
-                                    UEdGraphPin* OutP = nullptr;
-                                    for (UEdGraphPin* pp : CF->Pins)
-                                        if (pp && pp->Direction == EGPD_Output) { OutP = pp; break; }
-                                    if (OutP)
-                                    {
-                                        for (UEdGraphPin* L2 : OutP->LinkedTo)
-                                        {
-                                            if (!L2 || !L2->GetOwningNode()) continue;
-                                            if (L2->GetOwningNode()->GetClass()->GetName().Contains(TEXT("K2Node_CallFunction")))
-                                            {
-                                                UK2Node_CallFunction* CF2 = Cast<UK2Node_CallFunction>(L2->GetOwningNode());
-                                                if (UFunction* F2 = CF2 ? CF2->GetTargetFunction() : nullptr)
-                                                {
-                                                    if (F2->GetName().Contains(TEXT("Array_Get")))
-                                                    {
-                                                        UEdGraphPin* Idx = FindInputPinByName(CF2, TEXT("Index"));
-                                                        const FString D = PinDefaultOrText(Idx);
-                                                        if (D == TEXT("0")) How += TEXT("[0]");
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                    Emit(VarName, TEXT("is_acquired_via"), How, { A });
+                                    const FString D = G.PinDefaultOrText(G.FindInputPin(CF2, TEXT("Index")));
+                                    if (D == TEXT("0")) How += TEXT("[0]");
                                 }
                             }
                         }
+                        Emit(VarName, TEXT("is_acquired_via"), How, { A });
                     }
                 }
             }
 
             // 3) Branch controls_visibility_of (best-effort)
-            if (N->GetClass()->GetName().Contains(TEXT("K2Node_IfThenElse")))
+            if (G.HasFlag(N, BTD::NF_Branch))
             {
                 // condition source
                 FString Subject = TEXT("ComparisonResult");
-                if (UEdGraphPin* Cond = FindInputPinByName(N, TEXT("Condition")))
+                const int32 Cond = G.FindInputPin(N, TEXT("Condition"));
+                if (Cond != INDEX_NONE)
                 {
-                    for (UEdGraphPin* L : Cond->LinkedTo)
+                    for (const int32 L : G.Links(Cond))
                     {
-                        if (!L || !L->GetOwningNode()) continue;
+                        const int32 LN = G.PinNode[L];
                         // Try to extract variable driving the condition
-                        if (const UK2Node_VariableGet* Get = Cast<UK2Node_VariableGet>(L->GetOwningNode()))
+                        if (G.NodeKind[LN] == BTD::ENodeKind::VariableGet && G.NodeVar[LN])
                         {
-                            const FName V = Get->GetVarName();
-                            if (!V.IsNone()) Subject = V.ToString();
+                            Subject = G.Str(G.NodeVar[LN]);
                         }
-                        if (const UK2Node_CallFunction* CFcmp = Cast<UK2Node_CallFunction>(L->GetOwningNode()))
+                        if (G.NodeKind[LN] == BTD::ENodeKind::CallFunction && G.IsFunc(LN, BTD::FC_Compare))
                         {
-                            if (const UFunction* Fcmp = CFcmp->GetTargetFunction())
+                            FString VarName, ConstStr;
+                            for (int32 In = G.NodeFirstPin[LN], E = In + G.NodeNumPins[LN]; In < E; ++In)
                             {
-                                const FString Nm = Fcmp->GetName();
-                                if (Nm.StartsWith(TEXT("EqualEqual")) || Nm.StartsWith(TEXT("Greater")) || Nm.StartsWith(TEXT("Less")))
+                                if (!G.IsDataInput(In)) continue;
+                                if (!G.IsLinked(In))
                                 {
-                                    FString VarName, ConstStr;
-                                    for (UEdGraphPin* In : CFcmp->Pins)
-                                    {
-                                        if (!IsDataInputPin(In)) continue;
-                                        if (In->LinkedTo.Num() == 0)
-                                        {
-                                            const FString D = PinDefaultOrText(In);
-                                            if (!D.IsEmpty()) ConstStr = D;
-                                        }
-                                        else
-                                        {
-                                            for (UEdGraphPin* Lk : In->LinkedTo)
-                                            {
-                                                if (!Lk || !Lk->GetOwningNode()) continue;
-                                                if (const UK2Node_VariableGet* G2 = Cast<UK2Node_VariableGet>(Lk->GetOwningNode()))
-                                                {
-                                                    const FName Vn = G2->GetVarName();
-                                                    if (!Vn.IsNone()) VarName = Vn.ToString();
-                                                }
-                                            }
-                                        }
-                                    }
-                                    if (!VarName.IsEmpty() && !ConstStr.IsEmpty())
+                                    const FString D = G.PinDefaultOrText(In);
+                                    if (!D.IsEmpty()) ConstStr = D;
+                                }
+                                else
+                                {
+                                    for (const int32 Lk : G.Links(In))
                                     {
-                                        // 증거 앵커는 비교 노드의 앵커를 추가로 포함
-                                        TArray<FString> Ev = { A };
-                                        if (const FString* AComp = AKey.Find(CFcmp)) Ev.Add(*AComp);
-                                        Emit(VarName, TEXT("is_compared_to"), ConstStr, Ev);
+                                        const int32 G2 = G.PinNode[Lk];
+                                        if (G.NodeKind[G2] == BTD::ENodeKind::VariableGet && G.NodeVar[G2])
+                                            VarName = G.Str(G.NodeVar[G2]);
                                     }
                                 }
                             }
+                            if (!VarName.IsEmpty() && !ConstStr.IsEmpty())
+                            {
+                                // 증거 앵커는 비교 노드의 앵커를 추가로 포함
+                                Emit(VarName, TEXT("is_compared_to"), ConstStr, { A, G.AnchorKey(LN) });
+                            }
                         }
-
                     }
                 }
-                // follow Then/Else exec to find SetVisibility
+                // follow Then/Else exec (output pins) to find SetVisibility
                 auto FindVisTargetOnExec = [&](const TCHAR* ExecName)->FString {
-                    if (UEdGraphPin* Exec = FindInputPinByName(N, ExecName)) { /* not used */ }
-                    // outputs pins named Then/Else are outputs; scan outputs
-                    for (UEdGraphPin* P : N->Pins)
+                    for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
                     {
-                        if (!P || P->Direction != EGPD_Output) continue;
-                        const FString Nm = P->PinName.ToString();
-                        if (!Nm.Equals(ExecName, ESearchCase::IgnoreCase)) continue;
-                        for (UEdGraphPin* L : P->LinkedTo)
+                        if (G.IsInput(P)) continue;
+                        if (!G.Str(G.PinName[P]).Equals(ExecName, ESearchCase::IgnoreCase)) continue;
+                        for (const int32 L : G.Links(P))
                         {
-                            if (!L || !L->GetOwningNode()) continue;
-                            if (const UK2Node_CallFunction* CF = Cast<UK2Node_CallFunction>(L->GetOwningNode()))
+                            const int32 CF = G.PinNode[L];
+                            if (G.NodeKind[CF] == BTD::ENodeKind::CallFunction && G.IsFunc(CF, BTD::FC_SetVisibility))
                             {
-                                if (const UFunction* F = CF->GetTargetFunction())
-                                {
-                                    if (F->GetName().Contains(TEXT("SetVisibility")))
-                                    {
-                                        FString Target = GetCallTargetObjectVarName(CF);
-                                        if (Target.IsEmpty()) Target = TEXT("Widget");
-                                        return Target;
-                                    }
-                                }
+                                FString Target = G.Str(G.CallTargetObjectVarName(CF));
+                                if (Target.IsEmpty()) Target = TEXT("Widget");
+                                return Target;
                             }
                         }
                     }
@@ -575,15 +527,33 @@ static void BuildFactsForBP(
         } // nodes
     } // graphs
 
-    // Write NDJSON (one JSON per line)
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    IFileManager::Get().MakeDirectory(*BPDir, true);
-    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpfacts.ndjson"), *BP->GetName()));
-    FString Joined;
-    for (int32 i = 0; i < Lines.Num(); ++i) { Joined += Lines[i]; if (i + 1 < Lines.Num()) Joined += TEXT("\n"); }
-    WriteTextToFile(Joined, OutPath);
+    if (OutRefs)
+    {
+        for (int32 i = 0; i < Out.Num(); ++i) OutRefs->AddFactObject(Out.Str(Out[i].O));
+    }
+}
+
+static FString FactsPathFor(const FString& BPDir, const FString& BPName)
+{
+    return FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpfacts.ndjson"), *BPName));
+}
+
+// Write NDJSON (one JSON per line) — UObject 미사용, 워커 스레드에서 호출 가능
+// bBinary: 일괄 처리용 <BP>.bpfacts.bin도 기록 (BTD::FFactTable::Serialize)
+static void WriteFactsForBP(const FString& BPName, const FString& BPDir, const BTD::FFactTable& Facts, bool bBinary, BTD::FHashLedger& Ledger)
+{
+    {
+        BTD::FScopedUtf8Builder Lines;
+        BeginTextArtifact(*Lines, TEXT(".ndjson"));
+        WriteFactsNDJson(*Lines, Facts);
+        WriteUtf8ToFile(*Lines, FactsPathFor(BPDir, BPName), Ledger);
+    }
+    if (bBinary)
+    {
+        BTD::FScopedUtf8Builder Bytes;
+        Facts.Serialize(*Bytes);
+        WriteUtf8ToFile(*Bytes, FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpfacts.bin"), *BPName)), Ledger);
+    }
 }
 
 static FString FriendlyFromCategory(const FString& Cat, const FString& Sub)
@@ -611,25 +581,32 @@ static FString NormalizeEventIdForLabel(const FString& Id)
     return TEXT("Event/Custom");
 }
 
+// === Def-Use 공용 컨테이너/헬퍼 (파일 스코프) ===
+struct FObjDefUse {
+    TMap<FString, TSet<FString>> Writes;
+    TMap<FString, TSet<FString>> Reads;
+};
+
+struct FDefUseData {
+    TMap<FString, FObjDefUse> Objects;          // objects[Obj].Writes["Prop"] = {"@A..", ...}
+    TMap<FString, TSet<FString>> VarWrites;     // vars[Var].writes
+    TMap<FString, TSet<FString>> VarReads;      // vars[Var].reads
+};
+
 struct FPublicApiInfo { FString Name; };
 
-static void ExtractPublicApisFromFlows(const TArray<FString>& FlowJsonPaths, TArray<FPublicApiInfo>& Out)
+// 함수 그래프(FunctionEntry 보유, EventGraph 제외) = public API
+static void ExtractPublicApisFromGraphs(const TArray<BTD::FGraphIR>& Graphs, TArray<FPublicApiInfo>& Out)
 {
     Out.Reset();
-    for (const FString& P : FlowJsonPaths)
+    for (const BTD::FGraphIR& G : Graphs)
     {
-        TSharedPtr<FJsonObject> J = LoadJsonObject(P);
-        if (!J.IsValid()) continue;
-        FString GraphName; J->TryGetStringField(TEXT("graph_name"), GraphName);
+        const FString& GraphName = G.Str(G.Name);
         if (GraphName.IsEmpty() || GraphName.Equals(TEXT("EventGraph"), ESearchCase::IgnoreCase)) continue;
-        const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
-        if (!J->TryGetArrayField(TEXT("nodes"), Nodes)) continue;
         bool bHasEntry = false;
-        for (const TSharedPtr<FJsonValue>& V : *Nodes)
+        for (int32 N = 0; N < G.NumNodes(); ++N)
         {
-            const TSharedPtr<FJsonObject>* N; if (!V->TryGetObject(N)) continue;
-            FString Klass; (*N)->TryGetStringField(TEXT("class"), Klass);
-            if (Klass.Contains(TEXT("K2Node_FunctionEntry")))
+            if (G.Str(G.NodeClass[N]).Contains(TEXT("K2Node_FunctionEntry")))
             {
                 bHasEntry = true; break;
             }
@@ -644,79 +621,52 @@ static void ExtractPublicApisFromFlows(const TArray<FString>& FlowJsonPaths, TAr
     Out.Sort([](const FPublicApiInfo& A, const FPublicApiInfo& B) { return A.Name < B.Name; });
 }
 
-static void ExtractEntryPointsFromCatalog(const TSharedPtr<FJsonObject>& Catalog,
+static void ExtractEntryPointsFromSlices(const TArray<FFlowSlice>& Slices,
     TArray<FString>& OutIds /*flow.eventgraph.* only*/)
 {
     OutIds.Reset();
-    if (!Catalog.IsValid()) return;
-    const TArray<TSharedPtr<FJsonValue>>* Slices = nullptr;
-    if (!Catalog->TryGetArrayField(TEXT("slices"), Slices)) return;
-    for (const TSharedPtr<FJsonValue>& V : *Slices)
+    for (const FFlowSlice& S : Slices)
     {
-        const TSharedPtr<FJsonObject>* O; if (!V->TryGetObject(O)) continue;
-        FString Id; (*O)->TryGetStringField(TEXT("id"), Id);
-        if (Id.StartsWith(TEXT("flow.eventgraph.")))
+        if (S.Id.StartsWith(TEXT("flow.eventgraph.")))
         {
-            OutIds.Add(Id);
+            OutIds.Add(S.Id);
         }
     }
 }
 
 struct FVarMeta { FString Name; FString Cat; FString Sub; int Reads = 0; int Writes = 0; };
 
-static void ExtractVarUsage(const TSharedPtr<FJsonObject>& Meta, const TSharedPtr<FJsonObject>& DefUse, TArray<FVarMeta>& OutTop)
+// MetaVars: 스냅샷 시점의 BP 변수 (name/cat/sub), DefUse: CollectDefUseForBP 결과
+static void ExtractVarUsage(const TArray<FVarMeta>& MetaVars, const FDefUseData& DefUse, TArray<FVarMeta>& OutTop)
 {
     // Build map from name -> (cat, sub)
     TMap<FString, FVarMeta> Map;
-    if (Meta.IsValid())
+    for (const FVarMeta& V : MetaVars)
     {
-        const TArray<TSharedPtr<FJsonValue>>* Vars = nullptr;
-        if (Meta->TryGetArrayField(TEXT("variables"), Vars))
+        if (!V.Name.IsEmpty())
         {
-            for (const TSharedPtr<FJsonValue>& V : *Vars)
-            {
-                const TSharedPtr<FJsonObject>* O; if (!V->TryGetObject(O)) continue;
-                FVarMeta M;
-                (*O)->TryGetStringField(TEXT("name"), M.Name);
-                (*O)->TryGetStringField(TEXT("type_category"), M.Cat);
-                (*O)->TryGetStringField(TEXT("type_subcat"), M.Sub);
-                if (!M.Name.IsEmpty())
-                {
-                    Map.Add(M.Name, MoveTemp(M));
-                }
-            }
+            Map.Add(V.Name, V);
         }
     }
-    // Fill reads/writes from bpdefuse.json
-    if (DefUse.IsValid())
+    // Fill reads/writes from def-use vars
+    TSet<FString> VarNames;
+    for (const auto& K : DefUse.VarWrites) VarNames.Add(K.Key);
+    for (const auto& K : DefUse.VarReads)  VarNames.Add(K.Key);
+    for (const FString& Name : VarNames)
     {
-        const TSharedPtr<FJsonObject>* VarsObj = nullptr;
-        if (const TSharedPtr<FJsonObject>* VarsPtr = &DefUse->GetObjectField(TEXT("vars")))
+        const TSet<FString>* Reads = DefUse.VarReads.Find(Name);
+        const TSet<FString>* Writes = DefUse.VarWrites.Find(Name);
+        const int R = Reads ? Reads->Num() : 0;
+        const int W = Writes ? Writes->Num() : 0;
+        FVarMeta* M = Map.Find(Name);
+        if (!M)
         {
-            VarsObj = VarsPtr;
+            FVarMeta Tmp; Tmp.Name = Name; Tmp.Reads = R; Tmp.Writes = W;
+            Map.Add(Name, MoveTemp(Tmp));
         }
-        if (VarsObj && VarsObj->IsValid())
+        else
         {
-            for (const auto& Kvp : (*VarsObj)->Values)
-            {
-                const FString Name = Kvp.Key;
-                const TSharedPtr<FJsonObject>* VObj; if (!Kvp.Value->TryGetObject(VObj)) continue;
-                int R = 0, W = 0;
-                const TArray<TSharedPtr<FJsonValue>>* Reads = nullptr;
-                const TArray<TSharedPtr<FJsonValue>>* Writes = nullptr;
-                if ((*VObj)->TryGetArrayField(TEXT("reads"), Reads)) R = Reads->Num();
-                if ((*VObj)->TryGetArrayField(TEXT("writes"), Writes)) W = Writes->Num();
-                FVarMeta* M = Map.Find(Name);
-                if (!M)
-                {
-                    FVarMeta Tmp; Tmp.Name = Name; Tmp.Reads = R; Tmp.Writes = W;
-                    Map.Add(Name, MoveTemp(Tmp));
-                }
-                else
-                {
-                    M->Reads = R; M->Writes = W;
-                }
-            }
+            M->Reads = R; M->Writes = W;
         }
     }
     TArray<FVarMeta> Arr; Map.GenerateValueArray(Arr);
@@ -730,23 +680,14 @@ static void ExtractVarUsage(const TSharedPtr<FJsonObject>& Meta, const TSharedPt
     OutTop = MoveTemp(Arr);
 }
 
-static void ExtractDependencies(const TSharedPtr<FJsonObject>& DefUse, TArray<FString>& OutObjVars /*top few object vars*/)
+static void ExtractDependencies(const FDefUseData& DefUse, TArray<FString>& OutObjVars /*top few object vars*/)
 {
     OutObjVars.Reset();
-    if (!DefUse.IsValid()) return;
-    const TSharedPtr<FJsonObject>* Objs = nullptr;
-    if (!DefUse->TryGetObjectField(TEXT("objects"), Objs) || !Objs || !Objs->IsValid()) return;
     struct TScore { FString Name; int Score = 0; };
     TArray<TScore> Sc;
-    for (const auto& Kvp : (*Objs)->Values)
+    for (const auto& Kvp : DefUse.Objects)
     {
-        const FString ObjVar = Kvp.Key;
-        const TSharedPtr<FJsonObject>* One; if (!Kvp.Value->TryGetObject(One)) continue;
-        int R = 0, W = 0;
-        const TSharedPtr<FJsonObject>* RObj = nullptr; const TSharedPtr<FJsonObject>* WObj = nullptr;
-        if ((*One)->TryGetObjectField(TEXT("reads"), RObj) && RObj && RObj->IsValid()) R = (*RObj)->Values.Num();
-        if ((*One)->TryGetObjectField(TEXT("writes"), WObj) && WObj && WObj->IsValid()) W = (*WObj)->Values.Num();
-        Sc.Add({ ObjVar, R + W });
+        Sc.Add({ Kvp.Key, Kvp.Value.Reads.Num() + Kvp.Value.Writes.Num() });
     }
     Sc.Sort([](const TScore& A, const TScore& B) { if (A.Score != B.Score) return A.Score > B.Score; return A.Name < B.Name; });
     const int MaxN = FMath::Min(3, Sc.Num());
@@ -754,12 +695,7 @@ static void ExtractDependencies(const TSharedPtr<FJsonObject>& DefUse, TArray<FS
 }
 
 
-// === Def-Use 공용 컨테이너/헬퍼 (파일 스코프) ===
-struct FObjDefUse {
-    TMap<FString, TSet<FString>> Writes;
-    TMap<FString, TSet<FString>> Reads;
-};
-
+// === Def-Use 헬퍼 (파일 스코프) ===
 static void AddVarAnchor(TMap<FString, TSet<FString>>& Map, const FString& Key, const FString& Anchor)
 {
     Map.FindOrAdd(Key).Add(Anchor);
@@ -774,52 +710,66 @@ static void AddObjPropAnchor(TMap<FString, FObjDefUse>& Objects,
 }
 
 
-static void BuildDefUseForBP(
-    UBlueprint* BP,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
+static void CollectDefUseForBP(
+    const TArray<BTD::FGraphIR>& Graphs,
+    FDefUseData& Out);
+
+static void WriteDefUseForBP(
+    const FString& BPName,
+    const FString& BPDir,
+    const FDefUseData& Data,
     const FString& MetaFilePath,
     const TArray<FString>& FlowJsonPaths,
-    const FString& OutRoot);
+    BTD::FHashLedger& Ledger);
 
 // 모든 그래프의 슬라이스를 메모리에 수집 (카탈로그/요약 동시 사용)
 static void CollectSlicesForBP(
-    UBlueprint* /*BP*/,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
-    TArray<TSharedPtr<FJsonValue>>& OutSlices)
+    const TArray<BTD::FGraphIR>& Graphs,
+    TArray<FFlowSlice>& OutSlices)
 {
     OutSlices.Reset();
-    for (auto& KVP : SortedByGraph)
-        BuildSlicesForGraph(KVP.Key, KVP.Value, OutSlices);
+    for (const BTD::FGraphIR& G : Graphs)
+        BuildSlicesForGraph(G, OutSlices);
 }
 
 
-// bpcatalog.json 파일을 기록 (OutSlices는 CollectSlicesForBP 결과물)
+// bpcatalog.json 파일을 기록 (Slices는 CollectSlicesForBP 결과물)
+// GraphNames는 게임 스레드에서 미리 수집한 top-level 그래프 이름들
 static void WriteCatalogForBP_FromSlices(
-    UBlueprint* BP,
-    const TArray<TSharedPtr<FJsonValue>>& Slices,
-    const FString& OutRoot)
-{
-    if (!BP) return;
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    AddFrontMatter(J);
-    J->SetStringField(TEXT("bp"), BP->GetName());
+    const FString& BPName,
+    const FString& BPDir,
+    const TArray<FString>& GraphNames,
+    const TArray<FFlowSlice>& Slices,
+    BTD::FHashLedger& Ledger)
+{
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(*Json);
+    JW->WriteObjectStart();
+    WriteFrontMatter(*JW);
+    JW->WriteValue(TEXT("bp"), BPName);
 
     // graphs
-    TArray<TSharedPtr<FJsonValue>> GArr;
-    TArray<UEdGraph*> All; BP->GetAllGraphs(All);
-    for (UEdGraph* G : All) if (IsValid(G) && G->GetOuter() == BP)
-        GArr.Add(MakeShared<FJsonValueString>(G->GetName()));
-    J->SetArrayField(TEXT("graphs"), GArr);
+    JW->WriteArrayStart(TEXT("graphs"));
+    for (const FString& G : GraphNames)
+        JW->WriteValue(G);
+    JW->WriteArrayEnd();
 
     // slices
-    J->SetArrayField(TEXT("slices"), Slices);
-
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    IFileManager::Get().MakeDirectory(*BPDir, true);
+    JW->WriteArrayStart(TEXT("slices"));
+    for (const FFlowSlice& S : Slices)
+    {
+        JW->WriteObjectStart();
+        JW->WriteValue(TEXT("id"), S.Id);
+        JW->WriteValue(TEXT("type"), TEXT("flow"));
+        JW->WriteValue(TEXT("range"), S.Range);
+        JW->WriteValue(TEXT("source"), S.Source);
+        JW->WriteObjectEnd();
+    }
+    JW->WriteArrayEnd();
+    JW->WriteObjectEnd();
+    JW->Close();
 
-    WriteJsonToFile(*J, FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BP->GetName())));
+    WriteUtf8ToFile(*Json, FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BPName)), Ledger);
 }
 
 
@@ -841,9 +791,14 @@ static FString NormalizeEventName(const FString& Raw) {
 
 static FString PluginVersion()
 {
-    if (const TSharedPtr<IPlugin> P = IPluginManager::Get().FindPlugin(TEXT("BPTextDump")))
-        return P->GetDescriptor().VersionName;
-    return TEXT("0.3-dev");
+    // 첫 호출(게임 스레드)에서 캐시 → 워커 스레드에서 IPluginManager 조회 회피
+    static const FString Cached = []() -> FString
+        {
+            if (const TSharedPtr<IPlugin> P = IPluginManager::Get().FindPlugin(TEXT("BPTextDump")))
+                return P->GetDescriptor().VersionName;
+            return TEXT("0.3-dev");
+        }();
+    return Cached;
 }
 
 static void AddFrontMatter(TSharedRef<FJsonObject> J)
@@ -852,13 +807,15 @@ static void AddFrontMatter(TSharedRef<FJsonObject> J)
     J->SetStringField(TEXT("plugin_version"), PluginVersion());
 }
 
+// AddFrontMatter의 스트리밍 버전 (같은 필드, 같은 순서)
+static void WriteFrontMatter(FJsonStreamWriter& JW)
+{
+    JW.WriteValue(TEXT("ue_version"), FEngineVersion::Current().ToString());
+    JW.WriteValue(TEXT("plugin_version"), PluginVersion());
+}
 
 
 
-static bool IsInputDataPin(const UEdGraphPin* P)
-{
-    return P && P->Direction == EGPD_Input && P->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec;
-}
 
 static FString Sanitize(const FString& In)
 {
@@ -868,22 +825,21 @@ static FString Sanitize(const FString& In)
     return S.TrimStartAndEnd();
 }
 
-static FString PinDefaultInline(const UEdGraphPin* P)
+static FString PinDefaultInline(const BTD::FGraphIR& G, int32 P)
 {
-    if (!P) return TEXT("");
-    if (!P->DefaultTextValue.IsEmpty())
+    if (G.PinDefaultText[P])
     {
-        const FString S = Sanitize(P->DefaultTextValue.ToString());
+        const FString S = Sanitize(G.Str(G.PinDefaultText[P]));
         return FString::Printf(TEXT("\"%s\""), *S);
     }
-    if (!P->DefaultValue.IsEmpty())
+    if (G.PinDefault[P])
     {
-        const FString S = Sanitize(P->DefaultValue);
+        const FString S = Sanitize(G.Str(G.PinDefault[P]));
         return FString::Printf(TEXT("\"%s\""), *S);
     }
-    if (P->DefaultObject)
+    if (G.PinDefaultObject[P])
     {
-        return FString::Printf(TEXT("\"%s\""), *P->DefaultObject->GetPathName());
+        return FString::Printf(TEXT("\"%s\""), *G.Str(G.PinDefaultObject[P]));
     }
     return TEXT("");
 }
@@ -916,67 +872,69 @@ static FString AnchorsToPresetOrText(const FAnchors& A)
         A.Minimum.X, A.Minimum.Y, A.Maximum.X, A.Maximum.Y);
 }
 
-static TSharedRef<FJsonObject> MakeSlotJson(UWidget* W)
+// 슬롯 필드만 기록 (호출 측에서 오브젝트 시작/끝)
+static void WriteSlotJsonFields(FJsonStreamWriter& JW, UWidget* W)
 {
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    if (!W || !W->Slot) return J;
+    if (!W || !W->Slot) return;
 
     UPanelSlot* Slot = W->Slot;
-    J->SetStringField(TEXT("class"), Slot->GetClass()->GetName());
+    JW.WriteValue(TEXT("class"), Slot->GetClass()->GetName());
 
     // CanvasPanelSlot: anchors / pos / size / align / autosize
     if (UCanvasPanelSlot* CS = Cast<UCanvasPanelSlot>(Slot))
     {
-        J->SetStringField(TEXT("anchors"), AnchorsToPresetOrText(CS->GetAnchors()));
+        JW.WriteValue(TEXT("anchors"), AnchorsToPresetOrText(CS->GetAnchors()));
 
         const FVector2D Pos = CS->GetPosition();
-        J->SetStringField(TEXT("position"), Vec2ToStr(Pos));
+        JW.WriteValue(TEXT("position"), Vec2ToStr(Pos));
 
         const bool bAuto = CS->GetAutoSize();
-        J->SetBoolField(TEXT("size_to_content"), bAuto);
+        JW.WriteValue(TEXT("size_to_content"), bAuto);
 
         const FVector2D Size = CS->GetSize();
         if (!bAuto) {
-            J->SetStringField(TEXT("size"), Vec2ToStr(Size));
+            JW.WriteValue(TEXT("size"), Vec2ToStr(Size));
         }
 
         const FVector2D Align = CS->GetAlignment();
         if (!Align.IsZero()) {
-            J->SetStringField(TEXT("alignment"), Vec2ToStr(Align));
+            JW.WriteValue(TEXT("alignment"), Vec2ToStr(Align));
         }
     }
 
     // TODO: 필요해지면 다른 슬롯 유형(HBox/VBox/Overlay/Grid 등)도 여기서 확장
-
-    return J;
 }
 
-static TSharedRef<FJsonObject> WidgetToJson(UWidget* W, bool bIsRoot)
+// 위젯 1개(+자식 재귀)의 필드만 기록 (호출 측에서 오브젝트 시작/끝)
+static void WriteWidgetJsonFields(FJsonStreamWriter& JW, UWidget* W, bool bIsRoot)
 {
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    if (!W) return J;
+    if (!W) return;
 
     // 예시와 동일하게 루트는 name="RootWidget"으로 표기
-    J->SetStringField(TEXT("name"), bIsRoot ? TEXT("RootWidget") : W->GetName());
-    J->SetStringField(TEXT("class"), W->GetClass()->GetName());
+    JW.WriteValue(TEXT("name"), bIsRoot ? FString(TEXT("RootWidget")) : W->GetName());
+    JW.WriteValue(TEXT("class"), W->GetClass()->GetName());
 
     if (!bIsRoot && W->Slot) {
-        J->SetObjectField(TEXT("slot"), MakeSlotJson(W));
+        JW.WriteObjectStart(TEXT("slot"));
+        WriteSlotJsonFields(JW, W);
+        JW.WriteObjectEnd();
     }
 
-    TArray<TSharedPtr<FJsonValue>> JChildren;
+    JW.WriteArrayStart(TEXT("children"));
     if (UPanelWidget* Panel = Cast<UPanelWidget>(W)) {
         for (int32 i = 0; i < Panel->GetChildrenCount(); ++i) {
             if (UWidget* C = Panel->GetChildAt(i)) {
-                JChildren.Add(MakeShared<FJsonValueObject>(WidgetToJson(C, /*bIsRoot*/false)));
+                JW.WriteObjectStart();
+                WriteWidgetJsonFields(JW, C, /*bIsRoot*/false);
+                JW.WriteObjectEnd();
             }
         }
     }
-    J->SetArrayField(TEXT("children"), JChildren);
-    return J;
+    JW.WriteArrayEnd();
 }
 
-static TSharedPtr<FJsonObject> BuildWidgetTreeJson(UBlueprint* BP)
+// 위젯 블루프린트의 디자인 타임 루트 위젯 (없으면 nullptr)
+static UWidget* FindWidgetTreeRoot(UBlueprint* BP)
 {
     // 1) 위젯 블루프린트인지 확인
     UWidgetBlueprint* WBP = Cast<UWidgetBlueprint>(BP);
@@ -986,13 +944,10 @@ static TSharedPtr<FJsonObject> BuildWidgetTreeJson(UBlueprint* BP)
     UWidgetTree* WT = WBP->WidgetTree; // UBaseWidgetBlueprint가 보유
     if (!WT || !WT->RootWidget)
     {
-        UE_LOG(LogTemp, Warning, TEXT("BuildWidgetTreeJson: FAILED for %s. WidgetTree or RootWidget is null (design-time)."), *BP->GetName());
+        UE_LOG(LogTemp, Warning, TEXT("FindWidgetTreeRoot: FAILED for %s. WidgetTree or RootWidget is null (design-time)."), *BP->GetName());
         return nullptr;
     }
-
-    // 3) 기존의 WidgetToJson 재사용
-    UWidget* Root = WT->RootWidget;
-    return WidgetToJson(Root, /*bIsRoot*/true);
+    return WT->RootWidget;
 }
 
 
@@ -1116,622 +1071,603 @@ static FString ExportPropertyOnCDO(UBlueprint* BP, const FName VarName)
     return TEXT("");
 }
 
-static TSharedRef<FJsonObject> MakeBPContextJson(UBlueprint* BP)
+// bpmeta.json 본문 (게임 스레드 전용: UObject를 읽는다)
+static void MakeBPContextJson(const BTD::FBlueprintSymbols& Symbols, BTD::FUtf8Builder& Out)
 {
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    if (!BP) return J;
+    UBlueprint* BP = Symbols.GetBlueprint();
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(Out);
+    JW->WriteObjectStart();
+    if (!BP)
+    {
+        JW->WriteObjectEnd();
+        JW->Close();
+        return;
+    }
 
-    J->SetStringField(TEXT("bp_asset_class"), BP->GetClass()->GetName());
+    JW->WriteValue(TEXT("bp_asset_class"), BP->GetClass()->GetName());
 
     if (UClass* Parent = BP->ParentClass)
     {
-        J->SetStringField(TEXT("bp_parent_class"), Parent->GetName());
-        J->SetStringField(TEXT("bp_parent_class_path"), Parent->GetPathName());
+        JW->WriteValue(TEXT("bp_parent_class"), Parent->GetName());
+        JW->WriteValue(TEXT("bp_parent_class_path"), Parent->GetPathName());
     }
 
     // BlueprintType 안정 처리
     const TCHAR* TypeNames[] = { TEXT("Normal"), TEXT("Const"), TEXT("MacroLibrary"), TEXT("Interface"), TEXT("FunctionLibrary") };
     const int32 TypeIdx = (int32)BP->BlueprintType;
     const TCHAR* TypeName = (TypeIdx >= 0 && TypeIdx < (int32)UE_ARRAY_COUNT(TypeNames)) ? TypeNames[TypeIdx] : TEXT("Unknown");
-    J->SetStringField(TEXT("blueprint_type"), FString(TypeName));
+    JW->WriteValue(TEXT("blueprint_type"), FString(TypeName));
 
     // Interfaces
+    JW->WriteArrayStart(TEXT("implemented_interfaces"));
+    for (const FBPInterfaceDescription& D : BP->ImplementedInterfaces)
     {
-        TArray<TSharedPtr<FJsonValue>> Ifaces;
-        for (const FBPInterfaceDescription& D : BP->ImplementedInterfaces)
+        if (D.Interface)
         {
-            if (D.Interface)
-            {
-                Ifaces.Add(MakeShared<FJsonValueString>(D.Interface->GetPathName()));
-            }
+            JW->WriteValue(D.Interface->GetPathName());
         }
-        J->SetArrayField(TEXT("implemented_interfaces"), Ifaces);
     }
+    JW->WriteArrayEnd();
 
     // Variables
+    JW->WriteArrayStart(TEXT("variables"));
+    for (const FBPVariableDescription& V : BP->NewVariables)
     {
-        TArray<TSharedPtr<FJsonValue>> JVars;
-        for (const FBPVariableDescription& V : BP->NewVariables)
-        {
-            TSharedRef<FJsonObject> JV = MakeShared<FJsonObject>();
-            JV->SetStringField(TEXT("name"), V.VarName.ToString());
-            JV->SetStringField(TEXT("type_category"), V.VarType.PinCategory.ToString());
-            JV->SetStringField(TEXT("type_subcat"), V.VarType.PinSubCategory.ToString());
-            JV->SetStringField(TEXT("default_editor"), V.DefaultValue);
-            JV->SetStringField(TEXT("default_cdo"), ExportPropertyOnCDO(BP, V.VarName));
+        JW->WriteObjectStart();
+        JW->WriteValue(TEXT("name"), V.VarName.ToString());
+        JW->WriteValue(TEXT("type_category"), V.VarType.PinCategory.ToString());
+        JW->WriteValue(TEXT("type_subcat"), V.VarType.PinSubCategory.ToString());
+        JW->WriteValue(TEXT("default_editor"), V.DefaultValue);
+        JW->WriteValue(TEXT("default_cdo"), ExportPropertyOnCDO(BP, V.VarName));
 
-            const uint64 F = (uint64)V.PropertyFlags;
-            JV->SetStringField(TEXT("flags_hex"), FString::Printf(TEXT("0x%llx"), F));
-            JV->SetBoolField(TEXT("editable"), (F & CPF_Edit) != 0);
-            JV->SetBoolField(TEXT("blueprint_read_only"), (F & CPF_BlueprintReadOnly) != 0);
-            JV->SetBoolField(TEXT("instance_editable"), ((F & CPF_DisableEditOnInstance) == 0) && ((F & CPF_Edit) != 0));
-            JV->SetBoolField(TEXT("expose_on_spawn"), (F & CPF_ExposeOnSpawn) != 0);
+        const uint64 F = (uint64)V.PropertyFlags;
+        JW->WriteValue(TEXT("flags_hex"), FString::Printf(TEXT("0x%llx"), F));
+        JW->WriteValue(TEXT("editable"), (F & CPF_Edit) != 0);
+        JW->WriteValue(TEXT("blueprint_read_only"), (F & CPF_BlueprintReadOnly) != 0);
+        JW->WriteValue(TEXT("instance_editable"), ((F & CPF_DisableEditOnInstance) == 0) && ((F & CPF_Edit) != 0));
+        JW->WriteValue(TEXT("expose_on_spawn"), (F & CPF_ExposeOnSpawn) != 0);
 
-            JV->SetStringField(TEXT("category"), V.Category.ToString());
+        JW->WriteValue(TEXT("category"), V.Category.ToString());
 
-            // UE5.6: FBPVariableDescription에 직접 ToolTip 멤버 없음 → 안전하게 비움(원하면 차기버전에서 Editor API로 조회)
-            JV->SetStringField(TEXT("tooltip"), TEXT(""));
+        // UE5.6: FBPVariableDescription에 직접 ToolTip 멤버 없음 → 안전하게 비움(원하면 차기버전에서 Editor API로 조회)
+        JW->WriteValue(TEXT("tooltip"), FString());
 
-            // MetaData 전체 덤프는 UE5.6에선 공개 API 경로가 들쑥날쑥 → 건너뜀
-            JV->SetStringField(TEXT("defined_in"), ResolveVarDefinedIn(BP, V.VarName));
-            JVars.Add(MakeShared<FJsonValueObject>(JV));
-        }
-        J->SetArrayField(TEXT("variables"), JVars);
+        // MetaData 전체 덤프는 UE5.6에선 공개 API 경로가 들쑥날쑥 → 건너뜀
+        JW->WriteValue(TEXT("defined_in"), ResolveVarDefinedIn(BP, V.VarName));
+        JW->WriteObjectEnd();
     }
+    JW->WriteArrayEnd();
 
     // --- functions (source & origin) ---
     {
-        TArray<TSharedPtr<FJsonValue>> JFuncs;
-        TSet<FString> Dedup; // key = type|name
-
-        TArray<UEdGraph*> AllGraphs;
-        BP->GetAllGraphs(AllGraphs);
-        for (UEdGraph* G : AllGraphs)
+        // 비어 있으면 필드를 생략하므로 먼저 모은 뒤 기록
+        struct FFuncEntry { FString Name; const TCHAR* Type; FString DefinedIn; };
+        TArray<FFuncEntry> Funcs;
+        // 이벤트/커스텀 이벤트도 함수 목록으로 기록 (심볼 테이블에서 종류별 중복 제거됨)
+        for (const BTD::FFunctionSymbol& Sym : Symbols.GetFunctions())
         {
-            if (!IsValid(G) || G->GetOuter() != BP) continue; // top-level만
-
-            bool bHasFunctionEntry = false;
-            for (UEdGraphNode* N : G->Nodes)
-            {
-                if (IsValid(N) && N->IsA<UK2Node_FunctionEntry>()) { bHasFunctionEntry = true; break; }
-            }
-            if (bHasFunctionEntry)
-            {
-                const FString Name = G->GetName();
-                const FString Key = TEXT("function|") + Name;
-                if (!Dedup.Contains(Key))
-                {
-                    TSharedRef<FJsonObject> JF = MakeShared<FJsonObject>();
-                    JF->SetStringField(TEXT("name"), Name);
-                    JF->SetStringField(TEXT("type"), TEXT("function"));
-                    JF->SetStringField(TEXT("defined_in"), ResolveFunctionDefinedIn(BP, FName(*Name)));
-                    JFuncs.Add(MakeShared<FJsonValueObject>(JF));
-                    Dedup.Add(Key);
-                }
-            }
-
-            // 이벤트/커스텀 이벤트도 함수 목록으로 기록
-            for (UEdGraphNode* N : G->Nodes)
+            switch (Sym.Kind)
             {
-                if (!IsValid(N)) continue;
-                if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(N))
-                {
-                    const FName EvName = Ev->EventReference.GetMemberName();
-                    if (!EvName.IsNone())
-                    {
-                        const FString Name = EvName.ToString();
-                        const FString Key = TEXT("event|") + Name;
-                        if (!Dedup.Contains(Key))
-                        {
-                            TSharedRef<FJsonObject> JF = MakeShared<FJsonObject>();
-                            JF->SetStringField(TEXT("name"), Name);
-                            JF->SetStringField(TEXT("type"), TEXT("event"));
-                            JF->SetStringField(TEXT("defined_in"), ResolveFunctionDefinedIn(BP, EvName));
-                            JFuncs.Add(MakeShared<FJsonValueObject>(JF));
-                            Dedup.Add(Key);
-                        }
-                    }
-                }
-                else if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(N))
-                {
-                    const FString Name = CE->CustomFunctionName.ToString();
-                    if (!Name.IsEmpty())
-                    {
-                        const FString Key = TEXT("custom_event|") + Name;
-                        if (!Dedup.Contains(Key))
-                        {
-                            TSharedRef<FJsonObject> JF = MakeShared<FJsonObject>();
-                            JF->SetStringField(TEXT("name"), Name);
-                            JF->SetStringField(TEXT("type"), TEXT("custom_event"));
-                            JF->SetStringField(TEXT("defined_in"), GetSelfClassPath(BP));
-                            JFuncs.Add(MakeShared<FJsonValueObject>(JF));
-                            Dedup.Add(Key);
-                        }
-                    }
-                }
+            case BTD::ESymbolKind::Function:
+                Funcs.Add({ Sym.Name.ToString(), TEXT("function"), ResolveFunctionDefinedIn(BP, Sym.Name) });
+                break;
+            case BTD::ESymbolKind::Event:
+                Funcs.Add({ Sym.Name.ToString(), TEXT("event"), ResolveFunctionDefinedIn(BP, Sym.Name) });
+                break;
+            case BTD::ESymbolKind::CustomEvent:
+                Funcs.Add({ Sym.Name.ToString(), TEXT("custom_event"), GetSelfClassPath(BP) });
+                break;
             }
         }
-        if (JFuncs.Num() > 0)
+        if (Funcs.Num() > 0)
         {
-            J->SetArrayField(TEXT("functions"), JFuncs);
+            JW->WriteArrayStart(TEXT("functions"));
+            for (const FFuncEntry& F : Funcs)
+            {
+                JW->WriteObjectStart();
+                JW->WriteValue(TEXT("name"), F.Name);
+                JW->WriteValue(TEXT("type"), F.Type);
+                JW->WriteValue(TEXT("defined_in"), F.DefinedIn);
+                JW->WriteObjectEnd();
+            }
+            JW->WriteArrayEnd();
         }
     }
 
 
     // --- Component / Widget hierarchy (as text lines) ---
     {
-                // 그대로 유지 (컴포넌트 트리 라인)
-            TArray<FString> CompLines;
+        // 그대로 유지 (컴포넌트 트리 라인)
+        TArray<FString> CompLines;
         BuildComponentTreeLines(BP, CompLines);
         if (CompLines.Num() > 0)
-             {
-            TArray<TSharedPtr<FJsonValue>> JArr;
-            for (const FString& L : CompLines) JArr.Add(MakeShared<FJsonValueString>(L));
-            J->SetArrayField(TEXT("component_tree"), JArr);
-            }
-           // 필드명만 바꿔서 충돌 방지: widget_tree_lines
-            TArray<FString> WidgetLines;
+        {
+            JW->WriteArrayStart(TEXT("component_tree"));
+            for (const FString& L : CompLines) JW->WriteValue(L);
+            JW->WriteArrayEnd();
+        }
+        // 필드명만 바꿔서 충돌 방지: widget_tree_lines
+        TArray<FString> WidgetLines;
         BuildWidgetTreeLines(BP, WidgetLines);
         if (WidgetLines.Num() > 0)
-             {
-            TArray<TSharedPtr<FJsonValue>> JArr;
-            for (const FString& L : WidgetLines) JArr.Add(MakeShared<FJsonValueString>(L));
-            J->SetArrayField(TEXT("widget_tree_lines"), JArr);
-            }
-         }
-
-     if (TSharedPtr<FJsonObject> WTree = BuildWidgetTreeJson(BP))
-         {
-        J->SetObjectField(TEXT("widget_tree"), WTree.ToSharedRef());
+        {
+            JW->WriteArrayStart(TEXT("widget_tree_lines"));
+            for (const FString& L : WidgetLines) JW->WriteValue(L);
+            JW->WriteArrayEnd();
         }
-     return J;
-}
+    }
 
-static UEdGraph* FindFunctionGraphByName(UBlueprint* BP, const FName FuncName)
-{
-    if (!BP || FuncName.IsNone()) return nullptr;
-    TArray<UEdGraph*> All; BP->GetAllGraphs(All);
-    const FString Want = FuncName.ToString();
-    for (UEdGraph* G : All)
+    if (UWidget* Root = FindWidgetTreeRoot(BP))
     {
-        if (IsValid(G) && G->GetOuter() == BP && G->GetName() == Want)
-            return G;
+        JW->WriteObjectStart(TEXT("widget_tree"));
+        WriteWidgetJsonFields(*JW, Root, /*bIsRoot*/true);
+        JW->WriteObjectEnd();
     }
-    return nullptr;
+
+    JW->WriteObjectEnd();
+    JW->Close();
 }
 
-static UEdGraph* FindMacroGraphByName(UBlueprint* BP, const FName MacroName)
+// 게임 스레드 전용: UEdGraph → BTD::FGraphIR. 이후의 모든 에미터는 IR만 읽는다.
+// 앵커는 BP 단위 테이블(Anchors)에서 노드당 1회만 계산한다.
+static void CaptureGraphIR(const BTD::FBlueprintSymbols& Symbols, UEdGraph* Graph, BTD::FAnchorTable& Anchors, BTD::FGraphIR& G)
 {
-    if (!BP || MacroName.IsNone()) return nullptr;
-    TArray<UEdGraph*> All; BP->GetAllGraphs(All);
-    const FString Want = MacroName.ToString();
-    for (UEdGraph* G : All)
+    G.Name = G.Strings.Intern(Graph->GetName());
+    G.Anchors = &Anchors;
+
+    TArray<UEdGraphNode*> Src;
+    TMap<const UEdGraphPin*, int32> PinIdx;
+
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!IsValid(Node)) continue;
+        const int32 N = G.AddNode();
+        Src.Add(Node);
+
+        const FString ClassName = Node->GetClass()->GetName();
+        G.NodeGuid[N] = Node->NodeGuid;
+        G.NodeClass[N] = G.Strings.Intern(ClassName);
+        G.NodeTitle[N] = G.Strings.Intern(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+        G.NodeListTitle[N] = G.Strings.Intern(Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+        G.NodeComment[N] = G.Strings.Intern(Node->NodeComment);
+        G.NodePosX[N] = Node->NodePosX;
+        G.NodePosY[N] = Node->NodePosY;
+        G.NodeAnchor[N] = Anchors.FindOrAdd(Node, [Node]() { return BTD::AnchorForNode(Node); });
+
+        uint16 Flags = 0;
+        if (ClassName.Contains(TEXT("K2Node_IfThenElse")))  Flags |= BTD::NF_Branch;
+        if (ClassName.Contains(TEXT("K2Node_DynamicCast"))) Flags |= BTD::NF_DynamicCast;
+
+        if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node))
+        {
+            G.NodeKind[N] = BTD::ENodeKind::CallFunction;
+            if (UFunction* Fn = Call->GetTargetFunction())
+            {
+                Flags |= BTD::NF_HasFunction;
+                G.NodeFunc[N] = G.Strings.Intern(Fn->GetName());
+                const BTD::FFunctionClassInfo FnClass = BTD::FFunctionClassCache::Get().Find(Fn);
+                G.NodeFuncClass[N] = FnClass.Mask;
+                G.NodeFuncProp[N] = G.Strings.Intern(FnClass.Property);
+                if (UClass* Owner = Fn->GetOwnerClass())
+                {
+                    G.NodeFuncOwnerPath[N] = G.Strings.Intern(Owner->GetPathName());
+                    G.NodeFuncOwnerName[N] = G.Strings.Intern(Owner->GetName());
+                }
+                if (Fn->HasAnyFunctionFlags(FUNC_Const))  Flags |= BTD::NF_FnConst;
+                if (Fn->HasAnyFunctionFlags(FUNC_Static)) Flags |= BTD::NF_FnStatic;
+            }
+            if (Call->IsNodePure()) Flags |= BTD::NF_Pure;
+            if (Call->FunctionReference.IsSelfContext())
+            {
+                Flags |= BTD::NF_SelfContext;
+                if (UEdGraph* FG = Symbols.FindGraph(Call->FunctionReference.GetMemberName()))
+                    G.NodeCallee[N] = G.Strings.Intern(FG->GetName());
+            }
+        }
+        else if (const UK2Node_MacroInstance* MI = Cast<UK2Node_MacroInstance>(Node))
+        {
+            G.NodeKind[N] = BTD::ENodeKind::MacroInstance;
+            if (UEdGraph* MG = MI->GetMacroGraph())
+            {
+                Flags |= BTD::NF_HasMacroGraph;
+                G.NodeMember[N] = G.Strings.Intern(MG->GetName());
+                if (UBlueprint* SrcBP = MI->GetSourceBlueprint())
+                    G.NodeMacroSource[N] = G.Strings.Intern(SrcBP->GetPathName());
+            }
+        }
+        else if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(Node))
+        {
+            G.NodeKind[N] = BTD::ENodeKind::CustomEvent;
+            G.NodeMember[N] = G.Strings.Intern(CE->CustomFunctionName);
+        }
+        else if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(Node))
+        {
+            G.NodeKind[N] = BTD::ENodeKind::Event;
+            const FName EvName = Ev->EventReference.GetMemberName();
+            if (!EvName.IsNone()) G.NodeMember[N] = G.Strings.Intern(EvName);
+        }
+        else if (const UK2Node_Variable* VNode = Cast<UK2Node_Variable>(Node))
+        {
+            G.NodeKind[N] = Node->IsA<UK2Node_VariableGet>() ? BTD::ENodeKind::VariableGet
+                : Node->IsA<UK2Node_VariableSet>() ? BTD::ENodeKind::VariableSet
+                : BTD::ENodeKind::Variable;
+            const FName VarName = VNode->GetVarName();
+            if (!VarName.IsNone()) G.NodeVar[N] = G.Strings.Intern(VarName);
+        }
+        else if (Node->IsA<UK2Node_Knot>())
+        {
+            G.NodeKind[N] = BTD::ENodeKind::Knot;
+        }
+        else if (Node->IsA<UK2Node_FunctionEntry>())
+        {
+            G.NodeKind[N] = BTD::ENodeKind::FunctionEntry;
+        }
+        G.NodeFlags[N] = Flags;
+
+        for (UEdGraphPin* Pin : Node->Pins)
+        {
+            if (!Pin) continue;
+            const int32 P = G.AddPin(N);
+            PinIdx.Add(Pin, P);
+
+            G.PinName[P] = G.Strings.Intern(Pin->PinName);
+            G.PinCategory[P] = G.Strings.Intern(Pin->PinType.PinCategory);
+            G.PinSubCategory[P] = G.Strings.Intern(Pin->PinType.PinSubCategory);
+            G.PinDefault[P] = G.Strings.Intern(Pin->DefaultValue);
+            if (!Pin->DefaultTextValue.IsEmpty())
+                G.PinDefaultText[P] = G.Strings.Intern(Pin->DefaultTextValue.ToString());
+            if (Pin->DefaultObject)
+                G.PinDefaultObject[P] = G.Strings.Intern(Pin->DefaultObject->GetPathName());
+
+            uint8 PinFlags = 0;
+            if (Pin->Direction == EGPD_Input) PinFlags |= BTD::PF_Input;
+            if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) PinFlags |= BTD::PF_Exec;
+            if (Pin->PinType.bIsReference) PinFlags |= BTD::PF_ByRef;
+            if (Pin->LinkedTo.Num() > 0) PinFlags |= BTD::PF_Linked;
+            G.PinFlags[P] = PinFlags;
+        }
+    }
+
+    // 링크는 모든 핀 인덱스가 정해진 뒤에 채운다 (핀별로 연속 구간)
+    for (int32 N = 0; N < Src.Num(); ++N)
     {
-        if (IsValid(G) && G->GetOuter() == BP && G->GetName() == Want)
-            return G;
+        int32 P = G.NodeFirstPin[N];
+        for (UEdGraphPin* Pin : Src[N]->Pins)
+        {
+            if (!Pin) continue;
+            G.PinFirstLink[P] = G.LinkPin.Num();
+            for (UEdGraphPin* L : Pin->LinkedTo)
+            {
+                if (!L || !L->GetOwningNode()) continue;
+                if (const int32* To = PinIdx.Find(L))
+                {
+                    G.LinkPin.Add(*To);
+                    ++G.PinNumLinks[P];
+                }
+            }
+            ++P;
+        }
     }
-    return nullptr;
+
+    // Stable sort (PosY, PosX) — flow DSL / 슬라이스 / 분석 공용 순서
+    G.Sorted.Reserve(G.NumNodes());
+    for (int32 N = 0; N < G.NumNodes(); ++N) G.Sorted.Add(N);
+    G.Sorted.StableSort([&G](int32 A, int32 B)
+        {
+            if (G.NodePosY[A] != G.NodePosY[B]) return G.NodePosY[A] < G.NodePosY[B];
+            return G.NodePosX[A] < G.NodePosX[B];
+        });
 }
 
-static TSharedRef<FJsonObject> MakeNodeJson(UEdGraphNode* Node)
+static void WriteNodeJson(FJsonStreamWriter& JW, const BTD::FGraphIR& G, int32 N)
 {
-    TSharedRef<FJsonObject> JNode = MakeShared<FJsonObject>();
-    JNode->SetStringField(TEXT("guid"), Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphensInBraces));
-    JNode->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-    JNode->SetStringField(TEXT("title"), Sanitize(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString()));
-    JNode->SetStringField(TEXT("comment"), Sanitize(Node->NodeComment));
-    JNode->SetNumberField(TEXT("pos_x"), Node->NodePosX);
-    JNode->SetNumberField(TEXT("pos_y"), Node->NodePosY);
+    JW.WriteObjectStart();
+    JW.WriteValue(TEXT("guid"), G.NodeGuid[N].ToString(EGuidFormats::DigitsWithHyphensInBraces));
+    JW.WriteValue(TEXT("class"), G.Str(G.NodeClass[N]));
+    JW.WriteValue(TEXT("title"), Sanitize(G.Str(G.NodeTitle[N])));
+    JW.WriteValue(TEXT("comment"), Sanitize(G.Str(G.NodeComment[N])));
+    // DOM 시절(SetNumberField)과 같은 숫자 표기를 위해 double로 기록
+    JW.WriteValue(TEXT("pos_x"), (double)G.NodePosX[N]);
+    JW.WriteValue(TEXT("pos_y"), (double)G.NodePosY[N]);
 
-    const FString AKey = BTD::AnchorForNode(Node);
-    JNode->SetStringField(TEXT("akey"), AKey);
+    JW.WriteValue(TEXT("akey"), G.Anchor(N));
 
     // ---------- 노드별 메타 ----------
-    if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node))
+    switch (G.NodeKind[N])
+    {
+    case BTD::ENodeKind::CallFunction:
     {
-        TSharedRef<FJsonObject> JCall = MakeShared<FJsonObject>();
-        if (UFunction* Fn = Call->GetTargetFunction())
+        const bool bHasFn = G.HasFlag(N, BTD::NF_HasFunction);
+        const FString& OwnerPath = G.Str(G.NodeFuncOwnerPath[N]);
+        const FString& FnName = G.Str(G.NodeFunc[N]);
+        if (bHasFn)
         {
-            const FString OwnerPath = Fn->GetOwnerClass() ? Fn->GetOwnerClass()->GetPathName() : TEXT("");
-            const FString FnName = Fn->GetName();
-
-            // 기존 call 오브젝트 유지
-            JCall->SetStringField(TEXT("owner_class_path"), OwnerPath);
-            JCall->SetStringField(TEXT("function_name"), FnName);
-            JCall->SetBoolField(TEXT("is_const"), Fn->HasAnyFunctionFlags(FUNC_Const));
-            JCall->SetBoolField(TEXT("is_static"), Fn->HasAnyFunctionFlags(FUNC_Static));
+            JW.WriteValue(TEXT("function_name"), FnName);
+            JW.WriteValue(TEXT("function_owner_path"), OwnerPath);
+        }
 
-            JNode->SetStringField(TEXT("function_name"), FnName);
-            JNode->SetStringField(TEXT("function_owner_path"), OwnerPath);
+        // 기존 call 오브젝트 유지
+        JW.WriteObjectStart(TEXT("call"));
+        if (bHasFn)
+        {
+            JW.WriteValue(TEXT("owner_class_path"), OwnerPath);
+            JW.WriteValue(TEXT("function_name"), FnName);
+            JW.WriteValue(TEXT("is_const"), G.HasFlag(N, BTD::NF_FnConst));
+            JW.WriteValue(TEXT("is_static"), G.HasFlag(N, BTD::NF_FnStatic));
+        }
+        JW.WriteValue(TEXT("is_pure"), G.HasFlag(N, BTD::NF_Pure));
+        // self-context 호출 → 같은 BP의 함수 그래프 힌트
+        if (G.NodeCallee[N])
+        {
+            JW.WriteValue(TEXT("callee_graph_name"), G.Str(G.NodeCallee[N]));
         }
-        JCall->SetBoolField(TEXT("is_pure"), Call->IsNodePure());
-        JNode->SetObjectField(TEXT("call"), JCall);
+        JW.WriteObjectEnd();
+        break;
     }
-    else if (const UK2Node_MacroInstance* MI = Cast<UK2Node_MacroInstance>(Node))
+    case BTD::ENodeKind::MacroInstance:
     {
-        TSharedRef<FJsonObject> JMac = MakeShared<FJsonObject>();
-        if (MI->GetMacroGraph())
+        JW.WriteObjectStart(TEXT("macro"));
+        if (G.HasFlag(N, BTD::NF_HasMacroGraph))
         {
-            JMac->SetStringField(TEXT("macro_graph_name"), MI->GetMacroGraph()->GetName());
-            if (UBlueprint* SrcBP = MI->GetSourceBlueprint())
-                JMac->SetStringField(TEXT("macro_source_bp_path"), SrcBP->GetPathName());
+            JW.WriteValue(TEXT("macro_graph_name"), G.Str(G.NodeMember[N]));
+            if (G.NodeMacroSource[N])
+                JW.WriteValue(TEXT("macro_source_bp_path"), G.Str(G.NodeMacroSource[N]));
+            JW.WriteValue(TEXT("callee_graph_name"), G.Str(G.NodeMember[N]));
         }
-        JNode->SetObjectField(TEXT("macro"), JMac);
+        JW.WriteObjectEnd();
+        break;
     }
-    else if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(Node))
+    case BTD::ENodeKind::CustomEvent:
     {
-        const FString EvName = CE->CustomFunctionName.ToString();
-        TSharedRef<FJsonObject> JEv = MakeShared<FJsonObject>();
-        JEv->SetStringField(TEXT("event_name"), EvName);
-        JNode->SetObjectField(TEXT("custom_event"), JEv);
+        const FString& EvName = G.Str(G.NodeMember[N]);
+        JW.WriteObjectStart(TEXT("custom_event"));
+        JW.WriteValue(TEXT("event_name"), EvName);
+        JW.WriteObjectEnd();
 
-        JNode->SetStringField(TEXT("event_name"), EvName);
+        JW.WriteValue(TEXT("event_name"), EvName);
+        break;
     }
-    else if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(Node))
-    {
-        const FName EvFName = Ev->EventReference.GetMemberName();
-        const FString EvName = EvFName.IsNone() ? TEXT("") : EvFName.ToString();
-        if (!EvName.IsEmpty())
+    case BTD::ENodeKind::Event:
+        if (G.NodeMember[N])
         {
-            JNode->SetStringField(TEXT("event_name"), EvName);
+            JW.WriteValue(TEXT("event_name"), G.Str(G.NodeMember[N]));
         }
+        break;
+    default:
+        break;
     }
 
     // 변수 노드 (Get/Set 공통)
-    if (const UK2Node_Variable* VNode = Cast<UK2Node_Variable>(Node))
+    if (G.IsVariableNode(N) && G.NodeVar[N])
     {
-        const FName VarName = VNode->GetVarName();
-        if (!VarName.IsNone())
-        {
-            JNode->SetStringField(TEXT("variable_name"), VarName.ToString());
-        }
+        JW.WriteValue(TEXT("variable_name"), G.Str(G.NodeVar[N]));
     }
 
     // ---------- 핀들 ----------
-    TArray<TSharedPtr<FJsonValue>> JPins;
-    for (UEdGraphPin* Pin : Node->Pins)
+    JW.WriteArrayStart(TEXT("pins"));
+    for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
     {
-        if (!Pin) continue;
-        TSharedRef<FJsonObject> JPin = MakeShared<FJsonObject>();
-        const bool bExec = (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
-        const bool bInput = (Pin->Direction == EGPD_Input);
+        JW.WriteObjectStart();
+        const bool bInput = G.IsInput(P);
 
-        JPin->SetStringField(TEXT("name"), Pin->PinName.ToString());
-        JPin->SetStringField(TEXT("dir"), bInput ? TEXT("in") : TEXT("out"));
-        JPin->SetStringField(TEXT("category"), Pin->PinType.PinCategory.ToString());
-        JPin->SetStringField(TEXT("subcat"), Pin->PinType.PinSubCategory.ToString());
-        JPin->SetBoolField(TEXT("is_exec"), bExec);
-        JPin->SetBoolField(TEXT("is_by_ref"), Pin->PinType.bIsReference);
+        JW.WriteValue(TEXT("name"), G.Str(G.PinName[P]));
+        JW.WriteValue(TEXT("dir"), bInput ? TEXT("in") : TEXT("out"));
+        JW.WriteValue(TEXT("category"), G.Str(G.PinCategory[P]));
+        JW.WriteValue(TEXT("subcat"), G.Str(G.PinSubCategory[P]));
+        JW.WriteValue(TEXT("is_exec"), G.IsExec(P));
+        JW.WriteValue(TEXT("is_by_ref"), (G.PinFlags[P] & BTD::PF_ByRef) != 0);
 
-        const bool bLinked = Pin->LinkedTo.Num() > 0;
-        JPin->SetBoolField(TEXT("is_linked"), bLinked);
+        const bool bLinked = G.IsLinked(P);
+        JW.WriteValue(TEXT("is_linked"), bLinked);
 
         if (bInput && !bLinked)
         {
-            if (!Pin->DefaultValue.IsEmpty())
-                 JPin->SetStringField(TEXT("default_value"), Pin->DefaultValue);
-            if (!Pin->DefaultTextValue.IsEmpty())
-                 JPin->SetStringField(TEXT("default_text"), Pin->DefaultTextValue.ToString());
-            if (Pin->DefaultObject)
-                 JPin->SetStringField(TEXT("default_object_path"), Pin->DefaultObject->GetPathName());
+            if (G.PinDefault[P])
+                JW.WriteValue(TEXT("default_value"), G.Str(G.PinDefault[P]));
+            if (G.PinDefaultText[P])
+                JW.WriteValue(TEXT("default_text"), G.Str(G.PinDefaultText[P]));
+            if (G.PinDefaultObject[P])
+                JW.WriteValue(TEXT("default_object_path"), G.Str(G.PinDefaultObject[P]));
         }
 
         // links
-        TArray<TSharedPtr<FJsonValue>> JLinks;
-        for (UEdGraphPin* L : Pin->LinkedTo)
+        JW.WriteArrayStart(TEXT("links"));
+        for (const int32 L : G.Links(P))
         {
-            if (!L || !L->GetOwningNode()) continue;
-            TSharedRef<FJsonObject> JLink = MakeShared<FJsonObject>();
-            JLink->SetStringField(TEXT("to_guid"), L->GetOwningNode()->NodeGuid.ToString(EGuidFormats::DigitsWithHyphensInBraces));
-            JLink->SetStringField(TEXT("to_pin"), L->PinName.ToString());
-            JLinks.Add(MakeShared<FJsonValueObject>(JLink));
+            JW.WriteObjectStart();
+            JW.WriteValue(TEXT("to_guid"), G.NodeGuid[G.PinNode[L]].ToString(EGuidFormats::DigitsWithHyphensInBraces));
+            JW.WriteValue(TEXT("to_pin"), G.Str(G.PinName[L]));
+            JW.WriteObjectEnd();
         }
-        JPin->SetArrayField(TEXT("links"), JLinks);
-        JPins.Add(MakeShared<FJsonValueObject>(JPin));
+        JW.WriteArrayEnd();
+        JW.WriteObjectEnd();
     }
-    JNode->SetArrayField(TEXT("pins"), JPins);
-
-    return JNode;
-}
+    JW.WriteArrayEnd();
 
-
-static void AttachCalleeGraphHints(UBlueprint* BP, const TSharedRef<FJsonObject>& JNode, UEdGraphNode* Node)
-{
-    if (!BP || !Node) return;
-
-    if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node))
-    {
-        if (Call->FunctionReference.IsSelfContext())
-        {
-            if (UEdGraph* FG = FindFunctionGraphByName(BP, Call->FunctionReference.GetMemberName()))
-            {
-                TSharedPtr<FJsonObject> JCall = JNode->GetObjectField(TEXT("call"));
-                if (JCall.IsValid())
-                {
-                    JCall->SetStringField(TEXT("callee_graph_name"), FG->GetName());
-                }
-            }
-        }
-    }
-    else if (const UK2Node_MacroInstance* MI = Cast<UK2Node_MacroInstance>(Node))
-    {
-        if (UEdGraph* MG = MI->GetMacroGraph())
-        {
-            TSharedPtr<FJsonObject> JMac = JNode->GetObjectField(TEXT("macro"));
-            if (JMac.IsValid())
-            {
-                JMac->SetStringField(TEXT("callee_graph_name"), MG->GetName());
-            }
-        }
-    }
+    JW.WriteObjectEnd();
 }
 
-static TSharedRef<FJsonObject> MakeGraphJson(UBlueprint* BP, UEdGraph* Graph)
+// bpflow.json 전체를 Out에 직렬화 (front matter는 기존처럼 맨 뒤)
+static void WriteGraphJson(BTD::FUtf8Builder& Out, const FString& BPPackage, const FString& BPName, const BTD::FGraphIR& G)
 {
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    J->SetStringField(TEXT("bp_package"), BP->GetOutermost()->GetName());
-    J->SetStringField(TEXT("bp_name"), BP->GetName());
-    J->SetStringField(TEXT("graph_name"), Graph->GetName());
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(Out);
+    JW->WriteObjectStart();
+    JW->WriteValue(TEXT("bp_package"), BPPackage);
+    JW->WriteValue(TEXT("bp_name"), BPName);
+    JW->WriteValue(TEXT("graph_name"), G.Str(G.Name));
 
-    TArray<TSharedPtr<FJsonValue>> JNodes;
-    for (UEdGraphNode* Node : Graph->Nodes)
+    JW->WriteArrayStart(TEXT("nodes"));
+    for (int32 N = 0; N < G.NumNodes(); ++N)
     {
-        if (!IsValid(Node)) continue;
-        TSharedRef<FJsonObject> JNode = MakeNodeJson(Node);
-        AttachCalleeGraphHints(BP, JNode, Node);
-        JNodes.Add(MakeShared<FJsonValueObject>(JNode));
+        WriteNodeJson(*JW, G, N);
     }
-    J->SetArrayField(TEXT("nodes"), JNodes);
+    JW->WriteArrayEnd();
 
-    return J;
+    WriteFrontMatter(*JW);
+    JW->WriteObjectEnd();
+    JW->Close();
 }
 
-static void BuildSlicesForGraph(UEdGraph* Graph,
-    const TArray<UEdGraphNode*>& SortedNodes,
-    TArray<TSharedPtr<FJsonValue>>& Out)
+static void BuildSlicesForGraph(const BTD::FGraphIR& G,
+    TArray<FFlowSlice>& Out)
 {
-    if (!Graph || SortedNodes.Num() == 0) return;
+    const TArray<int32>& SortedNodes = G.Sorted;
+    if (SortedNodes.Num() == 0) return;
 
-    const FString GraphName = Graph->GetName();
+    const FString& GraphName = G.Str(G.Name);
     const FString GSlug = Slug(GraphName);
-    const FString AFirst = BTD::AnchorForNode(SortedNodes[0]);
-    const FString ALast = BTD::AnchorForNode(SortedNodes.Last());
+    const FString& AFirst = G.Anchor(SortedNodes[0]);
+    const FString& ALast = G.Anchor(SortedNodes.Last());
 
     const bool bIsEventGraph = (GSlug == TEXT("eventgraph"));
     if (bIsEventGraph)
     {
         // full
-        {
-            TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-            J->SetStringField(TEXT("id"), TEXT("flow.eventgraph.full"));
-            J->SetStringField(TEXT("type"), TEXT("flow"));
-            J->SetStringField(TEXT("range"), FString::Printf(TEXT("@%s-@%s"), *AFirst, *ALast));
-            J->SetStringField(TEXT("source"), GraphName);
-            Out.Add(MakeShared<FJsonValueObject>(J));
-        }
+        Out.Add({ TEXT("flow.eventgraph.full"), FString::Printf(TEXT("@%s-@%s"), *AFirst, *ALast), GraphName });
         // events
         struct Ev { int32 Idx; FString Id; };
         TArray<Ev> Entries;
         for (int32 i = 0; i < SortedNodes.Num(); ++i)
         {
-            if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(SortedNodes[i]))
-                Entries.Add({ i, FString::Printf(TEXT("flow.eventgraph.%s"), *NormalizeEventName(CE->CustomFunctionName.ToString())) });
-            else if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(SortedNodes[i]))
-            {
-                const FName FN = Ev->EventReference.GetMemberName();
-                Entries.Add({ i, FString::Printf(TEXT("flow.eventgraph.%s"), *NormalizeEventName(FN.IsNone() ? TEXT("event") : FN.ToString())) });
-            }
+            const int32 N = SortedNodes[i];
+            if (G.NodeKind[N] == BTD::ENodeKind::CustomEvent)
+                Entries.Add({ i, FString::Printf(TEXT("flow.eventgraph.%s"), *NormalizeEventName(G.Str(G.NodeMember[N]))) });
+            else if (G.NodeKind[N] == BTD::ENodeKind::Event)
+                Entries.Add({ i, FString::Printf(TEXT("flow.eventgraph.%s"), *NormalizeEventName(G.NodeMember[N] ? G.Str(G.NodeMember[N]) : FString(TEXT("event")))) });
         }
         for (int32 k = 0; k < Entries.Num(); ++k)
         {
             const int32 Start = Entries[k].Idx;
             const int32 End = (k + 1 < Entries.Num()) ? (Entries[k + 1].Idx - 1) : (SortedNodes.Num() - 1);
-            const FString A0 = BTD::AnchorForNode(SortedNodes[Start]);
-            const FString A1 = BTD::AnchorForNode(SortedNodes[End]);
-            TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-            J->SetStringField(TEXT("id"), Entries[k].Id);
-            J->SetStringField(TEXT("type"), TEXT("flow"));
-            J->SetStringField(TEXT("range"), FString::Printf(TEXT("@%s-@%s"), *A0, *A1));
-            J->SetStringField(TEXT("source"), GraphName);
-            Out.Add(MakeShared<FJsonValueObject>(J));
+            const FString& A0 = G.Anchor(SortedNodes[Start]);
+            const FString& A1 = G.Anchor(SortedNodes[End]);
+            Out.Add({ Entries[k].Id, FString::Printf(TEXT("@%s-@%s"), *A0, *A1), GraphName });
         }
         return;
     }
 
     // function/macro/etc → graph-wide slice
-    {
-        TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-        J->SetStringField(TEXT("id"), FString::Printf(TEXT("flow.%s"), *GSlug));
-        J->SetStringField(TEXT("type"), TEXT("flow"));
-        J->SetStringField(TEXT("range"), FString::Printf(TEXT("@%s-@%s"), *AFirst, *ALast));
-        J->SetStringField(TEXT("source"), GraphName);
-        Out.Add(MakeShared<FJsonValueObject>(J));
-    }
+    Out.Add({ FString::Printf(TEXT("flow.%s"), *GSlug), FString::Printf(TEXT("@%s-@%s"), *AFirst, *ALast), GraphName });
 }
 
-static bool WriteJsonToFile(const FJsonObject& Root, const FString& OutPath)
+// 완성된 버퍼를 write-behind 큐로 넘긴다 (Bytes는 비워짐, 디스크 대기 없음)
+static bool WriteUtf8ToFile(BTD::FUtf8Builder& Bytes, const FString& OutPath)
 {
-    FString JsonStr;
-    auto Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonStr);
-    if (!FJsonSerializer::Serialize(MakeShared<FJsonObject>(Root), Writer)) return false;
-    return FFileHelper::SaveStringToFile(JsonStr, *OutPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    return BTD::WriteArtifact(OutPath, MoveTemp(Bytes.Bytes));
 }
 
-static void WriteCatalogForBP(UBlueprint* BP,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
-    const FString& OutRoot)
+// BP 산출물용: 넘기기 직전의 바이트로 해시를 한 번 계산해 원장에 기록
+static bool WriteUtf8ToFile(BTD::FUtf8Builder& Bytes, const FString& OutPath, BTD::FHashLedger& Ledger)
 {
-    if (!BP) return;
-
-    TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
-    AddFrontMatter(J);
-    J->SetStringField(TEXT("bp"), BP->GetName());
+    Ledger.Record(OutPath, Bytes.GetData(), Bytes.Num());
+    return WriteUtf8ToFile(Bytes, OutPath);
+}
 
-    // graphs
-    TArray<TSharedPtr<FJsonValue>> GArr;
-    for (auto& KVP : SortedByGraph)
-        GArr.Add(MakeShared<FJsonValueString>(KVP.Key->GetName()));
-    J->SetArrayField(TEXT("graphs"), GArr);
+// 텍스트 산출물 인코딩 정책 (빌더 시작 시 적용)
+// - 윈도우: CRLF 정규화 (윈도우 뷰어 호환)
+// - md/txt: BOM 포함 → 레거시 뷰어 호환
+static void BeginTextArtifact(BTD::FUtf8Builder& Out, const TCHAR* Ext)
+{
+    const bool bWantBom = FCString::Strcmp(Ext, TEXT(".md")) == 0 || FCString::Strcmp(Ext, TEXT(".txt")) == 0;
+    Out.Reset(bWantBom, PLATFORM_WINDOWS != 0);
+}
 
-    // slices
-    TArray<TSharedPtr<FJsonValue>> SArr;
-    for (auto& KVP : SortedByGraph)
-        BuildSlicesForGraph(KVP.Key, KVP.Value, SArr);
-    J->SetArrayField(TEXT("slices"), SArr);
-
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    IFileManager::Get().MakeDirectory(*BPDir, true);
-
-    WriteJsonToFile(*J, FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BP->GetName())));
-}
-
-
-static bool WriteTextToFile(const FString& Text, const FString& OutPath)
+// DOM으로 남은 작은 파일들(manifest, project_references 등)용
+static bool WriteJsonToFile(const TSharedRef<FJsonObject>& Root, const FString& OutPath)
 {
-    // CRLF 정규화 (윈도우 뷰어 호환)
-    FString Norm = Text;
-#if PLATFORM_WINDOWS
-    Norm.ReplaceInline(TEXT("\r\n"), TEXT("\n"));
-    Norm.ReplaceInline(TEXT("\r"), TEXT("\n"));
-    Norm.ReplaceInline(TEXT("\n"), TEXT("\r\n"));
-#endif
-
-    // UTF-8로 변환
-    FTCHARToUTF8 Conv(*Norm);
-
-    // md/txt는 BOM 포함 저장 → 레거시 뷰어 호환
-    const bool bWantBom = OutPath.EndsWith(TEXT(".md")) || OutPath.EndsWith(TEXT(".txt"));
-
-    TArray<uint8> Bytes;
-    if (bWantBom) { Bytes.Add(0xEF); Bytes.Add(0xBB); Bytes.Add(0xBF); } // BOM
-    Bytes.Append(reinterpret_cast<const uint8*>(Conv.Get()), Conv.Length());
-
-    if (!FFileHelper::SaveArrayToFile(Bytes, *OutPath))
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to write %s"), *OutPath);
-        return false;
-    }
-    return true;
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> Writer = MakeJsonStreamWriter(*Json);
+    if (!FJsonSerializer::Serialize(Root, Writer)) return false;
+    return WriteUtf8ToFile(*Json, OutPath);
 }
 
-
-
 static FString DefaultOutDir()
 {
     return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BPTextDump"));
 }
 
-static void CollectTopLevelGraphs(UBlueprint* BP, TArray<UEdGraph*>& OutGraphs)
+// bpflow.txt 본문을 Out에 기록 (BeginTextArtifact 이후 호출)
+static void BuildBPFlowDSL(BTD::FUtf8Builder& Out, const FString& BPName, const BTD::FGraphIR& G)
 {
-    if (!BP) return;
-    TArray<UEdGraph*> All;
-    BP->GetAllGraphs(All); 
-    for (UEdGraph* G : All)
-    {
-        if (IsValid(G) && G->GetOuter() == BP)
-        {
-            OutGraphs.Add(G);
-        }
-    }
-}
+    Out.Appendf(TEXT("BP %s :: Graph %s\n"), *BPName, *G.Str(G.Name));
 
-static FString BuildBPFlowDSL(UBlueprint* BP, UEdGraph* Graph)
-{
-    FString Out;
-    Out += FString::Printf(TEXT("BP %s :: Graph %s\n"), *BP->GetName(), *Graph->GetName());
+    TArray<int32> Idx; Idx.SetNumZeroed(G.NumNodes()); int32 Next = 1;
+    for (const int32 N : G.Sorted) Idx[N] = Next++;
 
-    TArray<UEdGraphNode*> Nodes = Graph->Nodes;
-    Nodes.RemoveAll([](UEdGraphNode* N) { return !IsValid(N); });
-    Nodes.Sort([](const UEdGraphNode& A, const UEdGraphNode& B)
-        {
-            if (A.NodePosY != B.NodePosY) return A.NodePosY < B.NodePosY;
-            return A.NodePosX < B.NodePosX;
-        });
-
-    TMap<const UEdGraphNode*, int32> Idx; int32 Next = 1;
-    for (UEdGraphNode* N : Nodes) Idx.Add(N, Next++);
-
-    for (UEdGraphNode* N : Nodes)
+    for (const int32 N : G.Sorted)
     {
-        const FString Title = Sanitize(N->GetNodeTitle(ENodeTitleType::ListView).ToString());
-        const FString AKey = BTD::AnchorForNode(N);
+        const FString Title = Sanitize(G.Str(G.NodeListTitle[N]));
         FString Line = FString::Printf(TEXT("@%d[%s] %s | %s"),
-            Idx[N], *AKey, *N->GetClass()->GetName(), *Title);
+            Idx[N], *G.Anchor(N), *G.Str(G.NodeClass[N]), *Title);
 
 
-        if (const UK2Node_Variable* VNode = Cast<UK2Node_Variable>(N))
+        if (G.IsVariableNode(N))
         {
-            const FName VarName = VNode->GetVarName();
-            if (!VarName.IsNone())
+            if (G.NodeVar[N])
             {
-                Line += FString::Printf(TEXT(" | Var: %s"), *VarName.ToString());
+                Line += FString::Printf(TEXT(" | Var: %s"), *G.Str(G.NodeVar[N]));
             }
         }
-        else if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(N))
+        else if (G.NodeKind[N] == BTD::ENodeKind::CallFunction)
         {
-            if (UFunction* Fn = Call->GetTargetFunction())
+            if (G.HasFlag(N, BTD::NF_HasFunction))
             {
-                Line += FString::Printf(TEXT(" | Func: %s"), *Fn->GetName());
+                Line += FString::Printf(TEXT(" | Func: %s"), *G.Str(G.NodeFunc[N]));
 
                 int Shown = 0;
-                for (UEdGraphPin* P : N->Pins)
+                for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
                 {
-                    if (!IsInputDataPin(P)) continue;
-                    if (P->LinkedTo.Num() > 0) continue;
+                    if (!G.IsDataInput(P)) continue;
+                    if (G.IsLinked(P)) continue;
 
-                    const FString V = PinDefaultInline(P);
+                    const FString V = PinDefaultInline(G, P);
                     if (!V.IsEmpty())
                     {
-                        Line += FString::Printf(TEXT(" | %s: %s"), *P->PinName.ToString(), *V);
+                        Line += FString::Printf(TEXT(" | %s: %s"), *G.Str(G.PinName[P]), *V);
                         if (++Shown >= 3) break;
                     }
                 }
             }
         }
-        else if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(N))
+        else if (G.NodeKind[N] == BTD::ENodeKind::CustomEvent)
         {
-            Line += FString::Printf(TEXT(" | Event: %s"), *CE->CustomFunctionName.ToString());
+            Line += FString::Printf(TEXT(" | Event: %s"), *G.Str(G.NodeMember[N]));
         }
-        else if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(N))
+        else if (G.NodeKind[N] == BTD::ENodeKind::Event)
         {
-            const FName EvName = Ev->EventReference.GetMemberName();
-            if (!EvName.IsNone())
+            if (G.NodeMember[N])
             {
-                Line += FString::Printf(TEXT(" | Event: %s"), *EvName.ToString());
+                Line += FString::Printf(TEXT(" | Event: %s"), *G.Str(G.NodeMember[N]));
             }
         }
 
-        Out += Line + TEXT("\n");
+        Out += Line;
+        Out += TEXT("\n");
     }
 
-    for (UEdGraphNode* N : Nodes)
+    for (const int32 N : G.Sorted)
     {
-        for (UEdGraphPin* P : N->Pins)
+        for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
         {
-            if (!P || P->Direction != EGPD_Output) continue;
-            const bool bExec = (P->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
-            for (UEdGraphPin* L : P->LinkedTo)
+            if (G.IsInput(P)) continue;
+            const bool bExec = G.IsExec(P);
+            for (const int32 L : G.Links(P))
             {
-                if (!L || !L->GetOwningNode()) continue;
                 const int32 A = Idx[N];
-                const int32 B = Idx[L->GetOwningNode()];
+                const int32 B = Idx[G.PinNode[L]];
                 if (bExec)
                 {
-                    Out += FString::Printf(TEXT("@%d > @%d : %s\n"), A, B, *P->PinName.ToString());
+                    Out.Appendf(TEXT("@%d > @%d : %s\n"), A, B, *G.Str(G.PinName[P]));
                 }
                 else
                 {
-                    Out += FString::Printf(TEXT("@%d.%s -> @%d.%s\n"),
-                        A, *P->PinName.ToString(),
-                        B, *L->PinName.ToString());
+                    Out.Appendf(TEXT("@%d.%s -> @%d.%s\n"),
+                        A, *G.Str(G.PinName[P]),
+                        B, *G.Str(G.PinName[L]));
                 }
             }
         }
     }
-
-    return Out;
 }
 
 static bool LooksNumericStrict(const FString& X)
@@ -1749,14 +1685,9 @@ static bool LooksNumericStrict(const FString& X)
     return bDigit;
 }
 
-static void BuildLintForBP(
-    UBlueprint* BP,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
-    const FString& OutRoot)
+// Evidence 수집 컨테이너 (규칙들이 그래프별로 채우고 그래프 순서대로 합침)
+struct FLintEvidence
 {
-    if (!BP) return;
-
-    // Evidence 수집 컨테이너
     TMap<FString, TArray<FString>> MagicConstToAnchors;   // 상수 문자열 -> 앵커들
     TArray<TArray<FString>>        SingletonEvSets;       // 각 사례별 앵커 목록
     TArray<FString>                SkelAnchors;           // SKEL_* 발견 앵커
@@ -1764,165 +1695,190 @@ static void BuildLintForBP(
     TArray<FString>                HardPathAnchors;       // 하드 경로 리터럴
     int32                          GetAllActorsCount = 0; // 무거운 호출 카운트
 
-    // defuse/vars 로드 (Read/Write-only 변수 검출)
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    const FString DefUsePath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpdefuse.json"), *BP->GetName()));
-    TSharedPtr<FJsonObject> JDefUse = LoadJsonObject(DefUsePath);
-    struct FVRW { TArray<FString> R; TArray<FString> W; };
-    TMap<FString, FVRW> VarRW;
-    if (JDefUse.IsValid() && JDefUse->HasField(TEXT("vars")))
+    void Append(FLintEvidence&& Other)
     {
-        const TSharedPtr<FJsonObject>& VObj = JDefUse->GetObjectField(TEXT("vars"));
-        for (const auto& kv : VObj->Values)
+        for (TPair<FString, TArray<FString>>& KV : Other.MagicConstToAnchors)
+            MagicConstToAnchors.FindOrAdd(KV.Key).Append(MoveTemp(KV.Value));
+        SingletonEvSets.Append(MoveTemp(Other.SingletonEvSets));
+        SkelAnchors.Append(MoveTemp(Other.SkelAnchors));
+        UncheckedCastAnchors.Append(MoveTemp(Other.UncheckedCastAnchors));
+        HardPathAnchors.Append(MoveTemp(Other.HardPathAnchors));
+        GetAllActorsCount += Other.GetAllActorsCount;
+    }
+};
+
+using FLintRule = BTD::TLintRule<FLintEvidence>;
+
+// MagicConstant: 비교 노드에서 상수 입력 수집
+class FMagicConstantRule final : public FLintRule
+{
+public:
+    virtual const TCHAR* GetName() const override { return TEXT("MagicConstant"); }
+    virtual void Declare(BTD::FLintInterest& I) const override
+    {
+        I.FuncClass(BTD::FC_Compare);
+    }
+    virtual void VisitNode(const BTD::FGraphIR& G, int32 N, const FString& A, FLintEvidence& Out) const override
+    {
+        for (int32 In = G.NodeFirstPin[N], E = In + G.NodeNumPins[N]; In < E; ++In)
         {
-            const FString VName = kv.Key;
-            const TSharedPtr<FJsonObject>* One = nullptr;
-            if (!kv.Value->TryGetObject(One)) continue;
-            FVRW RW;
-            const TArray<TSharedPtr<FJsonValue>>* RArr = nullptr;
-            const TArray<TSharedPtr<FJsonValue>>* WArr = nullptr;
-            if ((*One)->TryGetArrayField(TEXT("reads"), RArr))
-                for (const auto& v : *RArr) { FString s; v->TryGetString(s); if (!s.IsEmpty()) RW.R.Add(s); }
-            if ((*One)->TryGetArrayField(TEXT("writes"), WArr))
-                for (const auto& v : *WArr) { FString s; v->TryGetString(s); if (!s.IsEmpty()) RW.W.Add(s); }
-            VarRW.Add(VName, MoveTemp(RW));
+            if (!G.IsDataInput(In) || G.IsLinked(In)) continue;
+            const FString D = G.PinDefaultOrText(In);
+            if (D.IsEmpty()) continue;
+            const bool bNum = LooksNumericStrict(D);
+            const bool bInteresting =
+                (!bNum && D.Len() >= 3) ||
+                (bNum && (FCString::Atod(*D) >= 100.0));
+            if (bInteresting) Out.MagicConstToAnchors.FindOrAdd(D).Add(A);
         }
     }
+};
 
-    // 그래프 스캔
-    for (const auto& KVP : SortedByGraph)
+// SingletonAssumption & GetAllActorsOfClass 카운트
+class FSingletonAssumptionRule final : public FLintRule
+{
+public:
+    virtual const TCHAR* GetName() const override { return TEXT("SingletonAssumption"); }
+    virtual void Declare(BTD::FLintInterest& I) const override { I.FuncClass(BTD::FC_GetAllActorsOfClass); }
+    virtual void VisitNode(const BTD::FGraphIR& G, int32 N, const FString& A, FLintEvidence& Out) const override
     {
-        const TArray<UEdGraphNode*>& Nodes = KVP.Value;
-        // 앵커 캐시
-        TMap<const UEdGraphNode*, FString> AKey;
-        for (UEdGraphNode* N : Nodes) if (IsValid(N)) AKey.Add(N, TEXT("@") + BTD::AnchorForNode(N));
-
-        for (UEdGraphNode* N : Nodes)
+        ++Out.GetAllActorsCount;
+        for (int32 OutPin = G.NodeFirstPin[N], E = OutPin + G.NodeNumPins[N]; OutPin < E; ++OutPin)
         {
-            if (!IsValid(N)) continue;
-            const FString A = AKey[N];
-
-            // MagicConstant: 비교 노드에서 상수 입력 수집
-            if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(N))
+            if (G.IsInput(OutPin)) continue;
+            for (const int32 L : G.Links(OutPin))
             {
-                const UFunction* Fn = Call->GetTargetFunction();
-                const FString FnName = Fn ? Fn->GetName() : TEXT("");
-                if (FnName.StartsWith(TEXT("EqualEqual")) ||
-                    FnName.StartsWith(TEXT("Greater")) ||
-                    FnName.StartsWith(TEXT("Less")))
+                const int32 ArrayGet = G.PinNode[L];
+                if (G.NodeKind[ArrayGet] != BTD::ENodeKind::CallFunction) continue;
+                if (!G.IsFunc(ArrayGet, BTD::FC_ArrayGet)) continue;
+                const FString D = G.PinDefaultOrText(G.FindInputPin(ArrayGet, TEXT("Index")));
+                if (D != TEXT("0")) continue;
+
+                TArray<FString> Ev; Ev.Add(A); Ev.Add(G.AnchorKey(ArrayGet));
+                for (int32 Out2 = G.NodeFirstPin[ArrayGet], E2 = Out2 + G.NodeNumPins[ArrayGet]; Out2 < E2; ++Out2)
                 {
-                    for (UEdGraphPin* In : N->Pins)
+                    if (G.IsInput(Out2)) continue;
+                    for (const int32 L2 : G.Links(Out2))
                     {
-                        if (!IsDataInputPin(In)) continue;
-                        if (In->LinkedTo.Num() == 0)
-                        {
-                            const FString D = PinDefaultOrText(In);
-                            if (!D.IsEmpty())
-                            {
-                                const bool bNum = LooksNumericStrict(D);
-                                const bool bInteresting =
-                                    (!bNum && D.Len() >= 3) ||
-                                    (bNum && (FCString::Atod(*D) >= 100.0));
-                                if (bInteresting)
-                                {
-                                    MagicConstToAnchors.FindOrAdd(D).Add(A);
-                                }
-                            }
-                        }
+                        if (G.NodeKind[G.PinNode[L2]] == BTD::ENodeKind::VariableSet)
+                            Ev.Add(G.AnchorKey(G.PinNode[L2]));
                     }
                 }
+                TSet<FString> Dd(Ev); Ev = Dd.Array(); Ev.Sort();
+                Out.SingletonEvSets.Add(MoveTemp(Ev));
             }
+        }
+    }
+};
 
-            // SingletonAssumption & GetAllActorsOfClass 카운트
-            if (const UK2Node_CallFunction* CF_GetAll = Cast<UK2Node_CallFunction>(N))
-            {
-                const UFunction* F = CF_GetAll->GetTargetFunction();
-                if (F && F->GetName().Contains(TEXT("GetAllActorsOfClass")))
-                {
-                    ++GetAllActorsCount;
-                    for (UEdGraphPin* Out : CF_GetAll->Pins)
-                    {
-                        if (!Out || Out->Direction != EGPD_Output) continue;
-                        for (UEdGraphPin* L : Out->LinkedTo)
-                        {
-                            if (!L || !L->GetOwningNode()) continue;
-                            UK2Node_CallFunction* CF_ArrayGet = Cast<UK2Node_CallFunction>(L->GetOwningNode());
-                            if (!CF_ArrayGet) continue;
-                            UFunction* F2 = CF_ArrayGet->GetTargetFunction();
-                            if (!F2 || !F2->GetName().Contains(TEXT("Array_Get"))) continue;
-                            UEdGraphPin* Idx = FindInputPinByName(CF_ArrayGet, TEXT("Index"));
-                            const FString D = PinDefaultOrText(Idx);
-                            if (D == TEXT("0"))
-                            {
-                                TArray<FString> Ev; Ev.Add(AKey[CF_GetAll]); Ev.Add(AKey[CF_ArrayGet]);
-                                for (UEdGraphPin* Out2 : CF_ArrayGet->Pins)
-                                {
-                                    if (!Out2 || Out2->Direction != EGPD_Output) continue;
-                                    for (UEdGraphPin* L2 : Out2->LinkedTo)
-                                    {
-                                        if (!L2 || !L2->GetOwningNode()) continue;
-                                        if (const UK2Node_VariableSet* VS = Cast<UK2Node_VariableSet>(L2->GetOwningNode()))
-                                        {
-                                            Ev.Add(AKey[VS]);
-                                        }
-                                    }
-                                }
-                                TSet<FString> Dd(Ev); Ev = Dd.Array(); Ev.Sort();
-                                SingletonEvSets.Add(MoveTemp(Ev));
-                            }
-                        }
-                    }
-                }
-            }
+// SKELPathDependency: SKEL_ 소유 클래스 호출, 입력 핀 기본값/오브젝트의 SKEL_ 경로
+class FSkelPathRule final : public FLintRule
+{
+public:
+    virtual const TCHAR* GetName() const override { return TEXT("SKELPathDependency"); }
+    virtual void Declare(BTD::FLintInterest& I) const override { I.AllKinds().InputPins(); }
+    virtual void VisitNode(const BTD::FGraphIR& G, int32 N, const FString& A, FLintEvidence& Out) const override
+    {
+        if (G.NodeKind[N] == BTD::ENodeKind::CallFunction && G.Str(G.NodeFuncOwnerPath[N]).Contains(TEXT("SKEL_")))
+            Out.SkelAnchors.Add(A);
+    }
+    virtual void VisitInputPin(const BTD::FGraphIR& G, int32 N, int32 P, const FString& A, FLintEvidence& Out) const override
+    {
+        if (G.Str(G.PinDefaultObject[P]).Contains(TEXT("SKEL_")) || G.Str(G.PinDefault[P]).Contains(TEXT("SKEL_")))
+            Out.SkelAnchors.Add(A);
+    }
+};
 
-            // SKELPathDependency + HardPathLiteral
-            if (const UK2Node_CallFunction* CF = Cast<UK2Node_CallFunction>(N))
-            {
-                const UFunction* Fn = CF->GetTargetFunction();
-                const FString OwnerPath = Fn && Fn->GetOwnerClass() ? Fn->GetOwnerClass()->GetPathName() : TEXT("");
-                if (OwnerPath.Contains(TEXT("SKEL_"))) SkelAnchors.Add(A);
-                for (UEdGraphPin* P : N->Pins)
-                {
-                    if (!P || P->Direction != EGPD_Input) continue;
-                    if (!P->DefaultValue.IsEmpty() && (P->DefaultValue.Contains(TEXT("/Game/")) || P->DefaultValue.Contains(TEXT("/Script/"))))
-                        HardPathAnchors.Add(A);
-                    if (!P->DefaultTextValue.IsEmpty())
-                    {
-                        const FString T = P->DefaultTextValue.ToString();
-                        if (T.Contains(TEXT("/Game/")) || T.Contains(TEXT("/Script/"))) HardPathAnchors.Add(A);
-                    }
-                }
-            }
-            for (UEdGraphPin* P : N->Pins)
-            {
-                if (!P || P->Direction != EGPD_Input) continue;
-                if (P->DefaultObject)
-                {
-                    const FString ObjPath = P->DefaultObject->GetPathName();
-                    if (ObjPath.Contains(TEXT("SKEL_"))) SkelAnchors.Add(A);
-                }
-                if (!P->DefaultValue.IsEmpty() && P->DefaultValue.Contains(TEXT("SKEL_"))) SkelAnchors.Add(A);
-                if (!P->DefaultValue.IsEmpty() && (P->DefaultValue.Contains(TEXT("/Game/")) || P->DefaultValue.Contains(TEXT("/Script/"))))
-                    HardPathAnchors.Add(A);
-            }
+// HardPathLiteral: 입력 핀 기본값(CallFunction은 텍스트 기본값도)의 /Game/, /Script/ 경로
+class FHardPathRule final : public FLintRule
+{
+public:
+    virtual const TCHAR* GetName() const override { return TEXT("HardPathLiteral"); }
+    virtual void Declare(BTD::FLintInterest& I) const override { I.AllKinds().InputPins(); }
+    virtual void VisitInputPin(const BTD::FGraphIR& G, int32 N, int32 P, const FString& A, FLintEvidence& Out) const override
+    {
+        auto IsHardPath = [](const FString& V) { return V.Contains(TEXT("/Game/")) || V.Contains(TEXT("/Script/")); };
+        if (IsHardPath(G.Str(G.PinDefault[P])) ||
+            (G.NodeKind[N] == BTD::ENodeKind::CallFunction && IsHardPath(G.Str(G.PinDefaultText[P]))))
+        {
+            Out.HardPathAnchors.Add(A);
+        }
+    }
+};
 
-            // UncheckedCast: Dynamic Cast 실패 핀 미연결
-            if (N->GetClass()->GetName().Contains(TEXT("K2Node_DynamicCast")))
+// UncheckedCast: Dynamic Cast 실패 핀 미연결
+class FUncheckedCastRule final : public FLintRule
+{
+public:
+    virtual const TCHAR* GetName() const override { return TEXT("UncheckedCast"); }
+    virtual void Declare(BTD::FLintInterest& I) const override { I.Flag(BTD::NF_DynamicCast); }
+    virtual void VisitNode(const BTD::FGraphIR& G, int32 N, const FString& A, FLintEvidence& Out) const override
+    {
+        for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
+        {
+            if (G.IsInput(P)) continue;
+            const FString& Nm = G.Str(G.PinName[P]);
+            if (Nm.Equals(TEXT("CastFailed"), ESearchCase::IgnoreCase) || Nm.Equals(TEXT("Cast Failed"), ESearchCase::IgnoreCase))
             {
-                for (UEdGraphPin* P : N->Pins)
-                {
-                    if (!P || P->Direction != EGPD_Output) continue;
-                    const FString Nm = P->PinName.ToString();
-                    if (Nm.Equals(TEXT("CastFailed"), ESearchCase::IgnoreCase) || Nm.Equals(TEXT("Cast Failed"), ESearchCase::IgnoreCase))
-                    {
-                        if (P->LinkedTo.Num() == 0) { UncheckedCastAnchors.Add(A); break; }
-                    }
-                }
+                if (!G.IsLinked(P)) { Out.UncheckedCastAnchors.Add(A); break; }
             }
-        } // for nodes
-    } // for graphs
+        }
+    }
+};
+
+// 린트 규칙 목록 (새 규칙은 여기 등록). 첫 호출 시 1회 구성, 이후 읽기 전용
+static const BTD::TLintDispatcher<FLintEvidence>& LintRules()
+{
+    static BTD::TLintDispatcher<FLintEvidence> Rules;
+    static const bool bRegistered = []()
+        {
+            Rules.Register(MakeUnique<FMagicConstantRule>());
+            Rules.Register(MakeUnique<FSingletonAssumptionRule>());
+            Rules.Register(MakeUnique<FSkelPathRule>());
+            Rules.Register(MakeUnique<FHardPathRule>());
+            Rules.Register(MakeUnique<FUncheckedCastRule>());
+            return true;
+        }();
+    (void)bRegistered;
+    return Rules;
+}
+
+static void CollectLintForBP(
+    const TArray<BTD::FGraphIR>& Graphs,
+    FLintEvidence& Lint)
+{
+    LintRules().Run(Graphs, Lint);
+}
+
+// bplint.md 작성 (UObject 미사용, 워커 스레드 가능). Lint는 정렬/중복제거로 변경됨
+static void WriteLintForBP(const FString& BPName, const FString& BPDir, FLintEvidence& Lint, const FDefUseData& DefUse, BTD::FHashLedger& Ledger)
+{
+    TMap<FString, TArray<FString>>& MagicConstToAnchors = Lint.MagicConstToAnchors;
+    TArray<TArray<FString>>&        SingletonEvSets = Lint.SingletonEvSets;
+    TArray<FString>&                SkelAnchors = Lint.SkelAnchors;
+    TArray<FString>&                UncheckedCastAnchors = Lint.UncheckedCastAnchors;
+    TArray<FString>&                HardPathAnchors = Lint.HardPathAnchors;
+    const int32                     GetAllActorsCount = Lint.GetAllActorsCount;
+
+    // def-use vars (Read/Write-only 변수 검출) — bpdefuse.json과 같은 이름 순서
+    struct FVRW { TArray<FString> R; TArray<FString> W; };
+    TMap<FString, FVRW> VarRW;
+    {
+        TSet<FString> AllVarNames;
+        for (const auto& K : DefUse.VarWrites) AllVarNames.Add(K.Key);
+        for (const auto& K : DefUse.VarReads)  AllVarNames.Add(K.Key);
+        TArray<FString> Names = AllVarNames.Array();
+        Names.Sort();
+        for (const FString& VName : Names)
+        {
+            FVRW RW;
+            if (const TSet<FString>* S = DefUse.VarReads.Find(VName))
+                for (const FString& A : *S) { if (!A.IsEmpty()) RW.R.Add(A); }
+            if (const TSet<FString>* S = DefUse.VarWrites.Find(VName))
+                for (const FString& A : *S) { if (!A.IsEmpty()) RW.W.Add(A); }
+            VarRW.Add(VName, MoveTemp(RW));
+        }
+    }
 
     // 리포트 구성
     int MagicIssues = 0;
@@ -1946,12 +1902,14 @@ static void BuildLintForBP(
     const int WarnCount = MagicIssues + SingletonIssues + UncheckedCastIssues + WriteOnlyIssues + (GetAllActorsCount >= 2 ? 1 : 0);
     const int InfoCount = SkelIssues + HardPathIssues + ReadOnlyIssues;
 
-    FString MD;
+    BTD::FScopedUtf8Builder MDBuf;
+    BeginTextArtifact(*MDBuf, TEXT(".md"));
+    BTD::FUtf8Builder& MD = *MDBuf;
     MD += TEXT("# Blueprint Lint Report: ");
-    MD += BP->GetName();
+    MD += BPName;
     MD += TEXT("\n\n## Summary\n");
-    MD += FString::Printf(TEXT("- ❗ **Warnings: %d**\n"), WarnCount);
-    MD += FString::Printf(TEXT("- ℹ️ **Infos: %d**\n\n---\n\n"), InfoCount);
+    MD.Appendf(TEXT("- ❗ **Warnings: %d**\n"), WarnCount);
+    MD.Appendf(TEXT("- ℹ️ **Infos: %d**\n\n---\n\n"), InfoCount);
 
     if (WarnCount > 0)
     {
@@ -1963,7 +1921,7 @@ static void BuildLintForBP(
             TSet<FString> Dd(Ev); Ev = Dd.Array(); Ev.Sort();
             if (Ev.Num() < 2) continue;
             MD += TEXT("- **[WARN][MagicConstant]**\n");
-            MD += FString::Printf(TEXT("  - **Description**: 리터럴 값 `%s`가 비교 로직에서 반복 사용됩니다. 의미를 명시하고 변경 비용을 줄이기 위해 상수/Enum으로 추출을 권장합니다.\n"), *kv.Key);
+            MD.Appendf(TEXT("  - **Description**: 리터럴 값 `%s`가 비교 로직에서 반복 사용됩니다. 의미를 명시하고 변경 비용을 줄이기 위해 상수/Enum으로 추출을 권장합니다.\n"), *kv.Key);
             MD += TEXT("  - **Evidence**: ");
             for (int i = 0; i < Ev.Num(); ++i) { if (i > 0) MD += TEXT(", "); MD += TEXT("⟦") + Ev[i] + TEXT("⟧"); }
             MD += TEXT("\n\n");
@@ -1994,7 +1952,7 @@ static void BuildLintForBP(
             if (RW.W.Num() > 0 && RW.R.Num() == 0)
             {
                 MD += TEXT("- **[WARN][WriteOnlyVariable]**\n");
-                MD += FString::Printf(TEXT("  - **Description**: 변수 `%s`는 값이 기록되지만 어디에서도 읽히지 않습니다. 불필요한 상태거나, 연결 누락일 수 있습니다.\n"), *Name);
+                MD.Appendf(TEXT("  - **Description**: 변수 `%s`는 값이 기록되지만 어디에서도 읽히지 않습니다. 불필요한 상태거나, 연결 누락일 수 있습니다.\n"), *Name);
                 MD += TEXT("  - **Evidence**: ");
                 TArray<FString> Ev = RW.W; TSet<FString> Dd2(Ev); Ev = Dd2.Array(); Ev.Sort();
                 for (int i = 0; i < Ev.Num(); ++i) { if (i > 0) MD += TEXT(", "); MD += TEXT("⟦") + Ev[i] + TEXT("⟧"); }
@@ -2039,7 +1997,7 @@ static void BuildLintForBP(
             if (RW.R.Num() > 0 && RW.W.Num() == 0)
             {
                 MD += TEXT("- **[INFO][ReadOnlyVariable]**\n");
-                MD += FString::Printf(TEXT("  - **Description**: 변수 `%s`는 읽히기만 하고 쓰이지 않습니다. 외부에서 세팅되거나 불변 상태라면 OK지만, 의도치 않은 미설정 가능성도 검토하세요.\n"), *Name);
+                MD.Appendf(TEXT("  - **Description**: 변수 `%s`는 읽히기만 하고 쓰이지 않습니다. 외부에서 세팅되거나 불변 상태라면 OK지만, 의도치 않은 미설정 가능성도 검토하세요.\n"), *Name);
                 MD += TEXT("  - **Evidence**: ");
                 TArray<FString> Ev = RW.R; TSet<FString> Dd2(Ev); Ev = Dd2.Array(); Ev.Sort();
                 for (int i = 0; i < Ev.Num(); ++i) { if (i > 0) MD += TEXT(", "); MD += TEXT("⟦") + Ev[i] + TEXT("⟧"); }
@@ -2049,245 +2007,496 @@ static void BuildLintForBP(
     }
 
     // 파일 출력
-    IFileManager::Get().MakeDirectory(*BPDir, true);
-    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bplint.md"), *BP->GetName()));
-    WriteTextToFile(MD, OutPath);
+    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bplint.md"), *BPName));
+    WriteUtf8ToFile(MD, OutPath, Ledger);
 }
 
 
-static int32 DumpBlueprintToDir(UBlueprint* BP, const FString& OutRoot)
-{
-    if (!BP) return 0;
-    TArray<UEdGraph*> Graphs; CollectTopLevelGraphs(BP, Graphs);
+// ============================================================
+// Dump pipeline: Snapshot (game thread) → Emit (any thread)
+// ============================================================
 
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    IFileManager::Get().MakeDirectory(*BPDir, true);
+// 게임 스레드에서 UObject를 읽어 만든 BP 1개 분량의 스냅샷.
+// 그래프는 BTD::FGraphIR(엔진 오브젝트 없음)로만 들고 있고, 이후 flow JSON/DSL,
+// 슬라이스, def-use, facts, 린트, 파일 기록은 모두 워커에서 IR로부터 만든다.
+struct FBPDumpJob
+{
+    FString BPName;
+    FString PackageName;
+    FString BPDir;
+    FString ParentPath;
+    TArray<FString> InterfacePaths;
+
+    BTD::FUtf8Builder MetaJson;     // bpmeta.json 본문 (스냅샷 시점에 UTF-8로 직렬화)
+    TArray<FVarMeta> MetaVars;      // bpmeta variables의 name/type (요약용)
+    BTD::FAnchorTable Anchors;      // BP 전체 노드 앵커 (그래프 IR들이 공유)
+    TArray<BTD::FGraphIR> Graphs;   // top-level 그래프, FBlueprintSymbols::GetGraphs 순서
+    bool bBinaryFacts = false;      // 설정 bWriteBinaryFacts (스냅샷 시점에 복사)
+};
 
-    // ① BP 메타 1회 기록
-    WriteJsonToFile(*MakeBPContextJson(BP), FPaths::Combine(BPDir, FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *BP->GetName())));
+// 앵커 테이블 / 린트 규칙 / 클래스 계층 캐시 누적 통계 (덤프 명령 단위로 리셋/로그)
+static std::atomic<int64> GAnchorHits{ 0 };
+static std::atomic<int64> GAnchorMisses{ 0 };
 
-    TMap<UEdGraph*, TArray<UEdGraphNode*>> SortedByGraph; // for catalog
+static void ResetDumpStats()
+{
+    GAnchorHits = 0;
+    GAnchorMisses = 0;
+    LintRules().ResetStats();
+    BTD::FClassHierarchyCache::Get().Reset();
+}
 
-    int32 Dumped = 0;
-    for (UEdGraph* G : Graphs)
-    {
-        if (!IsValid(G)) continue;
+static void LogDumpStats()
+{
+    const int64 Hits = GAnchorHits.load();
+    const int64 Misses = GAnchorMisses.load();
+    UE_LOG(LogTemp, Display, TEXT("BPTextDump: anchor table %lld computed, %lld reused (%.1f lookups/anchor)"),
+        Misses, Hits, Misses > 0 ? double(Hits + Misses) / double(Misses) : 0.0);
+    LintRules().LogStats(TEXT("BPTextDump"));
+    BTD::FClassHierarchyCache::Get().LogStats(TEXT("BPTextDump"));
+}
 
-        // Stable sort (same as DSL)
-        TArray<UEdGraphNode*> Nodes = G->Nodes;
-        Nodes.RemoveAll([](UEdGraphNode* N) { return !IsValid(N); });
-        Nodes.Sort([](const UEdGraphNode& A, const UEdGraphNode& B)
-            {
-                if (A.NodePosY != B.NodePosY) return A.NodePosY < B.NodePosY;
-                return A.NodePosX < B.NodePosX;
-            });
-        SortedByGraph.Add(G, Nodes);
+static TUniquePtr<FBPDumpJob> SnapshotBlueprint(UBlueprint* BP, const FString& OutRoot)
+{
+    if (!BP) return nullptr;
+    const BTD::FBlueprintSymbols Symbols(BP);
 
-        const FString Base = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__%s"), *BP->GetName(), *G->GetName()));
-        TSharedRef<FJsonObject> J = MakeGraphJson(BP, G);
-        AddFrontMatter(J);
-        WriteJsonToFile(*J, Base + TEXT(".bpflow.json"));
-        WriteTextToFile(BuildBPFlowDSL(BP, G), Base + TEXT(".bpflow.txt"));
-        ++Dumped;
+    TUniquePtr<FBPDumpJob> Job = MakeUnique<FBPDumpJob>();
+    Job->BPName = BP->GetName();
+    Job->PackageName = BP->GetOutermost()->GetName();
+    Job->BPDir = FPaths::Combine(OutRoot, FPaths::GetPath(Job->PackageName));
+    Job->ParentPath = (BP->ParentClass) ? BP->ParentClass->GetPathName() : TEXT("");
+    if (const UBPTextDumpSettings* S = GetDefault<UBPTextDumpSettings>())
+        Job->bBinaryFacts = S->bWriteBinaryFacts;
+    for (const FBPInterfaceDescription& D : BP->ImplementedInterfaces)
+    {
+        if (D.Interface) Job->InterfacePaths.Add(D.Interface->GetPathName());
     }
 
-    // 그래프별 정렬은 기존대로 끝났다고 가정
-    TArray<TSharedPtr<FJsonValue>> Slices;
-    CollectSlicesForBP(BP, SortedByGraph, Slices);
+    // ① BP 메타
+    MakeBPContextJson(Symbols, Job->MetaJson);
+    for (const FBPVariableDescription& V : BP->NewVariables)
+    {
+        FVarMeta& M = Job->MetaVars.AddDefaulted_GetRef();
+        M.Name = V.VarName.ToString();
+        M.Cat = V.VarType.PinCategory.ToString();
+        M.Sub = V.VarType.PinSubCategory.ToString();
+    }
 
-    // 카탈로그 파일 생성 (메모리 슬라이스 활용)
-    WriteCatalogForBP_FromSlices(BP, Slices, OutRoot);
+    // ② 그래프 IR (UObject 접근은 여기까지)
+    for (UEdGraph* G : Symbols.GetGraphs())
+    {
+        CaptureGraphIR(Symbols, G, Job->Anchors, Job->Graphs.AddDefaulted_GetRef());
+    }
+    return Job;
+}
 
-    // 해시 계산 대상 파일 목록 준비
-    TArray<FString> FlowJsonPaths;
-    for (UEdGraph* G : Graphs)
+// 스냅샷에서 레퍼런스 후보 수집: 부모/인터페이스, 핀 기본 오브젝트, (bWithFacts면) fact의 o 값
+static void CollectRefsFromJob(const FBPDumpJob& Job, FAssetRefSet& Out, bool bWithFacts)
+{
+    Out.AddPath(Job.ParentPath);
+    for (const FString& P : Job.InterfacePaths) Out.AddPath(P);
+
+    for (const BTD::FGraphIR& G : Job.Graphs)
     {
-        if (!IsValid(G)) continue;
-        const FString Base = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__%s"), *BP->GetName(), *G->GetName()));
-        FlowJsonPaths.Add(Base + TEXT(".bpflow.json"));
+        for (int32 P = 0; P < G.NumPins(); ++P)
+        {
+            // bpflow.json의 default_object_path와 같은 조건
+            if (G.PinDefaultObject[P] && G.IsInput(P) && !G.IsLinked(P))
+                Out.AddPath(G.Str(G.PinDefaultObject[P]));
+        }
     }
-    const FString MetaPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *BP->GetName()));
 
-    // bpsmry.md 생성
-    BuildAndWriteSummaryForBP(BP, Slices, MetaPath, FlowJsonPaths, OutRoot);
-    // bpdefuse.json 생성
-    BuildDefUseForBP(BP, SortedByGraph, MetaPath, FlowJsonPaths, OutRoot);
+    if (bWithFacts)
+    {
+        BTD::FFactTable Facts; // 레퍼런스 후보만 쓰고 버림
+        CollectFactsForBP(Job.BPName, Job.Graphs, Facts, &Out);
+    }
+}
 
-    BuildFactsForBP(BP, SortedByGraph, OutRoot);
-    BuildLintForBP(BP, SortedByGraph, OutRoot);
-    return Dumped;
+static FString RefsPathFor(const FString& BPDir, const FString& BPName)
+{
+    return FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bprefs.json"), *BPName));
 }
 
+// <BP>.bprefs.json: BP.ProjectRefs가 다른 산출물을 다시 읽지 않도록 레퍼런스 후보만 따로 기록
+static void WriteRefsForBP(const FString& BPName, const FString& BPDir, const FAssetRefSet& Refs, BTD::FHashLedger& Ledger)
+{
+    TArray<FString> Keys = Refs.Keys.Array();   Keys.Sort();
+    TArray<FString> Names = Refs.Names.Array(); Names.Sort();
 
-// ---------------- module ----------------
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(*Json);
+    JW->WriteObjectStart();
+    WriteFrontMatter(*JW);
+    JW->WriteValue(TEXT("bp"), BPName);
+    JW->WriteArrayStart(TEXT("keys"));
+    for (const FString& K : Keys) JW->WriteValue(K);
+    JW->WriteArrayEnd();
+    JW->WriteArrayStart(TEXT("names"));
+    for (const FString& N : Names) JW->WriteValue(N);
+    JW->WriteArrayEnd();
+    JW->WriteObjectEnd();
+    JW->Close();
+
+    WriteUtf8ToFile(*Json, RefsPathFor(BPDir, BPName), Ledger);
+}
 
-// --- 내부 도우미 ---
-static bool IsDataInputPin(const UEdGraphPin* P)
+static bool LoadRefsForBP(const FString& BPDir, const FString& BPName, FAssetRefSet& Out)
 {
-    return P && P->Direction == EGPD_Input && P->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec;
+    TSharedPtr<FJsonObject> J = LoadJsonObject(RefsPathFor(BPDir, BPName));
+    if (!J.IsValid()) return false;
+    const TArray<TSharedPtr<FJsonValue>>* Arr = nullptr;
+    if (J->TryGetArrayField(TEXT("keys"), Arr))
+        for (const auto& V : *Arr) { FString K; if (V->TryGetString(K)) Out.Keys.Add(K); }
+    if (J->TryGetArrayField(TEXT("names"), Arr))
+        for (const auto& V : *Arr) { FString N; if (V->TryGetString(N)) Out.Names.Add(N); }
+    return true;
 }
 
+static FString FragmentPathFor(const FString& BPDir, const FString& BPName)
+{
+    return FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpstore"), *BPName));
+}
 
-// 입력 핀에서 VariableGet까지 링크를 따라가 객체 변수명을 추출한다.
-// UK2Node_Knot(리루트) 같은 중간 노드는 재귀적으로 관통한다.
-static FString GetObjectVarNameFromInputPin(UEdGraphPin* Pin)
+// <BP>.bpstore: BP.ProjectRefs Store가 project_graph.btdstore로 합치는 바이너리 조각
+static void WriteGraphFragmentForBP(const FBPDumpJob& Job, BTD::FHashLedger& Ledger)
 {
-    if (!Pin) return TEXT("");
+    BTD::FScopedUtf8Builder Bytes;
+    BTD::BuildGraphFragment(Job.PackageName, Job.Graphs, *Bytes);
+    WriteUtf8ToFile(*Bytes, FragmentPathFor(Job.BPDir, Job.BPName), Ledger);
+}
 
-    TSet<UEdGraphPin*> Visited;
-    TArray<UEdGraphPin*> Stack;
+// <BP>.hashes.json: 이번 덤프에서 기록한 산출물별 해시 (파일 이름 → 해시, 기록 순서)
+static void WriteHashLedgerForBP(const FString& BPName, const FString& BPDir,
+    const BTD::FHashLedger& Ledger, const TArray<FString>& FlowJsonPaths)
+{
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(*Json);
+    JW->WriteObjectStart();
+    WriteFrontMatter(*JW);
+    JW->WriteValue(TEXT("bp"), BPName);
+    JW->WriteValue(TEXT("bpflow"), Ledger.Combined(FlowJsonPaths));
+    JW->WriteObjectStart(TEXT("artifacts"));
+    for (const TPair<FString, FString>& E : Ledger.Entries)
+    {
+        JW->WriteValue(FPaths::GetCleanFilename(E.Key), E.Value);
+    }
+    JW->WriteObjectEnd();
+    JW->WriteObjectEnd();
+    JW->Close();
 
-    for (UEdGraphPin* L : Pin->LinkedTo)
-        if (L) Stack.Add(L);
+    WriteUtf8ToFile(*Json, FPaths::Combine(BPDir, FString::Printf(TEXT("%s.hashes.json"), *BPName)));
+}
 
-    while (!Stack.IsEmpty())
-    {
-        // ↓ Pop 대체 (deprecated 회피)
-        UEdGraphPin* P = Stack.Last();
-        Stack.RemoveAt(Stack.Num() - 1, 1, EAllowShrinking::No);
+// 스냅샷 → 파일들. UObject를 건드리지 않으므로 워커 스레드에서 호출 가능
+// OutRefs가 있으면 bprefs.json에 기록한 레퍼런스 후보를 돌려줌
+static int32 EmitBlueprintJob(FBPDumpJob& Job, FAssetRefSet* OutRefs = nullptr)
+{
+    const FString& BPDir = Job.BPDir; // 디렉터리는 writer가 처음 기록할 때 생성
+    BTD::FHashLedger Ledger;          // 산출물 해시 (기록 시점에 계산, hashes.json으로 기록)
 
-        if (!P || Visited.Contains(P)) continue;
-        Visited.Add(P);
+    // ① BP 메타 1회 기록
+    const FString MetaPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *Job.BPName));
+    WriteUtf8ToFile(Job.MetaJson, MetaPath, Ledger);
 
-        UEdGraphNode* Node = P->GetOwningNode();
-        if (!Node) continue;
+    // 해시 계산 대상 파일 목록 준비
+    TArray<FString> FlowJsonPaths;
+    TArray<FString> GraphNames;
+    int32 Dumped = 0;
+    for (const BTD::FGraphIR& G : Job.Graphs)
+    {
+        const FString& GraphName = G.Str(G.Name);
+        GraphNames.Add(GraphName);
 
-        if (const UK2Node_VariableGet* Get = Cast<UK2Node_VariableGet>(Node))
+        const FString Base = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__%s"), *Job.BPName, *GraphName));
         {
-            const FName Var = Get->GetVarName();
-            if (!Var.IsNone()) return Var.ToString();
+            BTD::FScopedUtf8Builder Json;
+            WriteGraphJson(*Json, Job.PackageName, Job.BPName, G);
+            WriteUtf8ToFile(*Json, Base + TEXT(".bpflow.json"), Ledger);
         }
-
-        if (const UK2Node_Knot* Knot = Cast<UK2Node_Knot>(Node))
         {
-            for (UEdGraphPin* InPin : Knot->Pins)
-            {
-                if (!InPin || InPin->Direction != EGPD_Input) continue; // ← 여기
-                for (UEdGraphPin* L2 : InPin->LinkedTo)
-                    if (L2) Stack.Add(L2);
-            }
-            continue;
+            BTD::FScopedUtf8Builder Dsl;
+            BeginTextArtifact(*Dsl, TEXT(".txt"));
+            BuildBPFlowDSL(*Dsl, Job.BPName, G);
+            WriteUtf8ToFile(*Dsl, Base + TEXT(".bpflow.txt"), Ledger);
         }
+        FlowJsonPaths.Add(Base + TEXT(".bpflow.json"));
+        ++Dumped;
+    }
 
-        // 필요 시 다른 노드 유형도 확장 가능
+    // 카탈로그 파일 생성 (메모리 슬라이스 활용)
+    TArray<FFlowSlice> Slices;
+    CollectSlicesForBP(Job.Graphs, Slices);
+    WriteCatalogForBP_FromSlices(Job.BPName, BPDir, GraphNames, Slices, Ledger);
+
+    // def-use 수집 (bpdefuse.json / 요약 / 린트가 같은 결과를 공유)
+    FDefUseData DefUse;
+    CollectDefUseForBP(Job.Graphs, DefUse);
+
+    // bpsmry.md 생성
+    BuildAndWriteSummaryForBP(Job, Slices, DefUse, MetaPath, FlowJsonPaths, Ledger);
+    // bpdefuse.json 생성
+    WriteDefUseForBP(Job.BPName, BPDir, DefUse, MetaPath, FlowJsonPaths, Ledger);
+
+    FAssetRefSet Refs;
+    CollectRefsFromJob(Job, Refs, /*bWithFacts*/ false);
+    {
+        BTD::FFactTable Facts;
+        CollectFactsForBP(Job.BPName, Job.Graphs, Facts, &Refs);
+        WriteFactsForBP(Job.BPName, BPDir, Facts, Job.bBinaryFacts, Ledger);
     }
+    WriteRefsForBP(Job.BPName, BPDir, Refs, Ledger);
+    if (OutRefs) *OutRefs = MoveTemp(Refs);
+    WriteGraphFragmentForBP(Job, Ledger);
 
-    return TEXT("");
+    FLintEvidence Lint;
+    CollectLintForBP(Job.Graphs, Lint);
+    WriteLintForBP(Job.BPName, BPDir, Lint, DefUse, Ledger);
+
+    // 해시 원장 (마지막에 기록, 자기 자신은 제외)
+    WriteHashLedgerForBP(Job.BPName, BPDir, Ledger, FlowJsonPaths);
+
+    GAnchorHits += Job.Anchors.GetHits();
+    GAnchorMisses += Job.Anchors.GetMisses();
+    return Dumped;
 }
 
+static int32 DumpBlueprintToDir(UBlueprint* BP, const FString& OutRoot)
+{
+    TUniquePtr<FBPDumpJob> Job = SnapshotBlueprint(BP, OutRoot);
+    return Job ? EmitBlueprintJob(*Job) : 0;
+}
 
+// ============================================================
+// Incremental manifest: package → change key (plugin version | artifact format | saved hash)
+// ============================================================
+static FString ManifestPathFor(const FString& OutRoot, const FString& Suffix = FString())
+{
+    return FPaths::Combine(OutRoot, FString::Printf(TEXT("bptextdump_manifest%s.json"), *Suffix));
+}
 
+// BP별 산출물의 내용/구성이 바뀌는 커밋마다 올린다 → 증분 실행이 옛 형식 산출물을 건너뛰지 않음
+static constexpr int32 ArtifactFormatVersion = 2;
 
-// CallFunction의 대상 객체 변수명 추출: 보통 "self" 또는 "Target" 입력핀을 본다.
-static FString GetCallTargetObjectVarName(const UK2Node_CallFunction* Call)
+// 에셋을 로드하지 않고 레지스트리 정보만으로 변경 키를 만든다. 빈 문자열 = 판단 불가(항상 덤프)
+static FString ChangeKeyForAsset(const FAssetData& AD)
 {
-    if (!Call) return TEXT("");
+    // 에디터에서 수정 중(미저장)인 패키지는 디스크 해시와 내용이 다르다
+    if (const UPackage* Pkg = FindPackage(nullptr, *AD.PackageName.ToString()))
+    {
+        if (Pkg->IsDirty()) return FString();
+    }
+
+    FString Saved;
+    IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (const TOptional<FAssetPackageData> PD = AR.GetAssetPackageDataCopy(AD.PackageName))
+    {
+        if (!PD->GetPackageSavedHash().IsZero())
+            Saved = FString::Printf(TEXT("%s:%lld"), *LexToString(PD->GetPackageSavedHash()), PD->DiskSize);
+    }
+    if (Saved.IsEmpty())
+    {
+        // fallback: 패키지 파일 타임스탬프 + 크기
+        FString File;
+        if (FPackageName::DoesPackageExist(AD.PackageName.ToString(), &File))
+        {
+            Saved = FString::Printf(TEXT("ts:%s:%lld"),
+                *IFileManager::Get().GetTimeStamp(*File).ToIso8601(), IFileManager::Get().FileSize(*File));
+        }
+    }
+    if (Saved.IsEmpty()) return FString();
+    return FString::Printf(TEXT("%s|f%d|%s"), *PluginVersion(), ArtifactFormatVersion, *Saved);
+}
 
-    UEdGraphPin* SelfPin = nullptr;
-    UEdGraphPin* TargetPin = nullptr;
+struct FDumpManifest
+{
+    TMap<FString, FString> Keys;   // package name → change key
+    int32 Skipped = 0;
+    FString Suffix;                // 샤드 실행이면 ".shard-i-of-N" (샤드끼리 같은 Out을 써도 충돌 없음)
 
-    for (UEdGraphPin* Pin : Call->Pins)
+    void Load(const FString& OutRoot)
     {
-        if (!Pin || Pin->Direction != EGPD_Input) continue;
-        const FString N = Pin->PinName.ToString();
-        if (N.Equals(TEXT("self"), ESearchCase::IgnoreCase))
+        Keys.Reset();
+        TSharedPtr<FJsonObject> J = LoadJsonObject(ManifestPathFor(OutRoot, Suffix));
+        const TSharedPtr<FJsonObject>* Pkgs = nullptr;
+        if (!J.IsValid() || !J->TryGetObjectField(TEXT("packages"), Pkgs)) return;
+        for (const auto& KV : (*Pkgs)->Values)
         {
-            SelfPin = Pin;
+            FString K;
+            if (KV.Value->TryGetString(K)) Keys.Add(KV.Key, K);
         }
-        else if (N.Equals(TEXT("Target"), ESearchCase::IgnoreCase))
+    }
+
+    void Save(const FString& OutRoot) const
+    {
+        TArray<FString> Names; Keys.GenerateKeyArray(Names);
+        Names.Sort();
+
+        TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
+        AddFrontMatter(J);
+        TSharedRef<FJsonObject> JPkgs = MakeShared<FJsonObject>();
+        for (const FString& N : Names) JPkgs->SetStringField(N, Keys[N]);
+        J->SetObjectField(TEXT("packages"), JPkgs);
+        WriteJsonToFile(J, ManifestPathFor(OutRoot, Suffix));
+    }
+
+    // 이번 실행의 산출물이 모두 기록된 뒤에만 저장. 기록 실패가 있으면 이전 매니페스트를 그대로 두어
+    // 다음 증분 실행이 이번에 덤프한 BP를 다시 덤프하게 한다
+    void SaveIfWritten(const FString& OutRoot, const TCHAR* Label) const
+    {
+        BTD::FlushArtifacts();
+        if (const int32 Failed = BTD::OutputStats().Failed.load())
         {
-            TargetPin = Pin;
+            UE_LOG(LogTemp, Warning, TEXT("%s: %d artifact writes failed, manifest not updated (changed Blueprints are dumped again next run)"),
+                Label, Failed);
+            return;
         }
+        Save(OutRoot);
     }
 
-    if (SelfPin)
+    // 키가 같고 산출물(bpmeta)이 남아 있으면 최신
+    bool IsUpToDate(const FAssetData& AD, const FString& Key, const FString& OutRoot) const
     {
-        FString V = GetObjectVarNameFromInputPin(SelfPin);
-        if (!V.IsEmpty()) return V;
+        if (Key.IsEmpty()) return false;
+        const FString PkgName = AD.PackageName.ToString();
+        const FString* Prev = Keys.Find(PkgName);
+        if (!Prev || !Prev->Equals(Key, ESearchCase::CaseSensitive)) return false;
+        const FString BPDir = FPaths::Combine(OutRoot, FPaths::GetPath(PkgName));
+        return IFileManager::Get().FileExists(*FPaths::Combine(BPDir,
+            FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *AD.AssetName.ToString())));
     }
-    if (TargetPin)
+
+    void Record(const FAssetData& AD, const FString& Key)
     {
-        FString V = GetObjectVarNameFromInputPin(TargetPin);
-        if (!V.IsEmpty()) return V;
+        if (Key.IsEmpty()) Keys.Remove(AD.PackageName.ToString());
+        else               Keys.Add(AD.PackageName.ToString(), Key);
     }
+};
 
-    return TEXT("");
+static bool IsForceArg(const FString& A)
+{
+    return A.Equals(TEXT("Force"), ESearchCase::IgnoreCase) || A.Equals(TEXT("Force=1")) || A.Equals(TEXT("Force=true"), ESearchCase::IgnoreCase);
 }
 
+// 비동기 패키지 prefetch 창 크기. Prefetch=N 인자 > 설정값, 0이면 기존처럼 동기 로드
+static int32 DefaultPrefetchWindow()
+{
+    if (const UBPTextDumpSettings* S = GetDefault<UBPTextDumpSettings>())
+        return FMath::Clamp(S->PrefetchWindow, 0, 128);
+    return 8;
+}
 
-// 함수명에서 속성명/읽기·쓰기 유형을 추출한다: SetXxx → write "Xxx", GetYyy → read "Yyy"
-static bool ExtractPropertyFromFunctionName(const FString& FnName, FString& OutProp, bool& bIsWrite)
+static bool ParsePrefetchArg(const FString& A, int32& OutWindow)
 {
-    if (FnName.StartsWith(TEXT("Set")))
+    if (!A.StartsWith(TEXT("Prefetch="))) return false;
+    OutWindow = FMath::Clamp(FCString::Atoi(*A.RightChop(9)), 0, 128);
+    return true;
+}
+
+// MemBudgetMB=N: 상주 메모리가 N MB를 넘으면 이번 명령이 로드한 패키지를 놓아주고 GC (0 = 끔)
+static bool ParseMemBudgetArg(const FString& A, int32& OutMB)
+{
+    if (!A.StartsWith(TEXT("MemBudgetMB="))) return false;
+    OutMB = FMath::Max(0, FCString::Atoi(*A.RightChop(12)));
+    return true;
+}
+
+// Shard=i/N (0 <= i < N): 패키지 이름의 안정 해시로 자산 목록을 N개로 나눔.
+// 패키지 이름만으로 정해지므로 어느 머신/프로세스에서 돌려도 같은 샤드에 들어간다.
+struct FShardSpec
+{
+    int32 Index = 0;
+    int32 Count = 1;
+
+    bool IsSharded() const { return Count > 1; }
+
+    bool Owns(const FAssetData& AD) const
     {
-        OutProp = FnName.Mid(3); // SetVisibility -> Visibility
-        bIsWrite = true;  return !OutProp.IsEmpty();
+        if (!IsSharded()) return true;
+        // FName 비교는 대소문자 무시이므로 해시도 소문자 기준
+        const uint32 H = FCrc::StrCrc32(*AD.PackageName.ToString().ToLower());
+        return int32(H % uint32(Count)) == Index;
     }
-    if (FnName.StartsWith(TEXT("Get")))
+
+    FString Suffix() const
     {
-        OutProp = FnName.Mid(3); // GetText -> Text
-        bIsWrite = false; return !OutProp.IsEmpty();
+        return IsSharded() ? FString::Printf(TEXT(".shard-%d-of-%d"), Index, Count) : FString();
     }
-    // 특수 예외(원하면 확장)
-    // e.g., "K2_SetRelativeLocation" → RelativeLocation 등도 필요하면 여기서 규칙 추가
-    return false;
-}
 
+    void Filter(TArray<FAssetData>& Assets, const TCHAR* Label) const
+    {
+        if (!IsSharded()) return;
+        const int32 Before = Assets.Num();
+        Assets.RemoveAll([this](const FAssetData& AD) { return !Owns(AD); });
+        UE_LOG(LogTemp, Display, TEXT("%s: shard %d/%d owns %d of %d assets"), Label, Index, Count, Assets.Num(), Before);
+    }
+};
 
-// --- 메인: Def–Use 구축 & 파일 기록 ---
-static void BuildDefUseForBP(
-    UBlueprint* BP,
-    const TMap<UEdGraph*, TArray<UEdGraphNode*>>& SortedByGraph,
-    const FString& MetaFilePath,
-    const TArray<FString>& FlowJsonPaths,
-    const FString& OutRoot)
+// false = Shard= 인자가 아님. bOutValid=false면 형식 오류
+static bool ParseShardArg(const FString& A, FShardSpec& OutShard, bool& bOutValid)
 {
-    if (!BP) return;
+    if (!A.StartsWith(TEXT("Shard="))) return false;
+    FString L, R;
+    bOutValid = A.RightChop(6).Split(TEXT("/"), &L, &R)
+        && L.IsNumeric() && R.IsNumeric();
+    if (bOutValid)
+    {
+        OutShard.Index = FCString::Atoi(*L);
+        OutShard.Count = FCString::Atoi(*R);
+        bOutValid = OutShard.Count >= 1 && OutShard.Index >= 0 && OutShard.Index < OutShard.Count;
+    }
+    if (!bOutValid) UE_LOG(LogTemp, Error, TEXT("Invalid %s (expected Shard=i/N with 0 <= i < N)"), *A);
+    return true;
+}
+
+// 덤프 사이사이 로딩을 진행시키는 시간 (게임 스레드가 로딩을 처리하는 경우에만 쓰임)
+static constexpr double PrefetchPumpSeconds = 0.005;
+
 
-    TMap<FString, FObjDefUse> Objects;          // objects[Obj].Writes["Prop"] = {"@A..", ...}
-    TMap<FString, TSet<FString>> VarWrites;     // vars[Var].writes
-    TMap<FString, TSet<FString>> VarReads;      // vars[Var].reads
+
+// ---------------- module ----------------
+
+// --- 메인: Def–Use 구축 (IR 기반, 워커 스레드 가능) ---
+static void CollectDefUseForBP(
+    const TArray<BTD::FGraphIR>& Graphs,
+    FDefUseData& Out)
+{
+    TMap<FString, FObjDefUse>& Objects = Out.Objects;
+    TMap<FString, TSet<FString>>& VarWrites = Out.VarWrites;
+    TMap<FString, TSet<FString>>& VarReads = Out.VarReads;
 
 
     // 그래프 순회
-    for (const auto& KVP : SortedByGraph)
+    for (const BTD::FGraphIR& G : Graphs)
     {
-        for (UEdGraphNode* N : KVP.Value)
+        for (const int32 N : G.Sorted)
         {
-            if (!IsValid(N)) continue;
-            const FString NodeAnchor = TEXT("@") + BTD::AnchorForNode(N); // ← 딱 1번만
+            const FString& NodeAnchor = G.AnchorKey(N);
 
-            if (const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(N)) {
-                const FName Var = SetNode->GetVarName();
-                if (!Var.IsNone()) AddVarAnchor(VarWrites, Var.ToString(), NodeAnchor);
+            if (G.NodeKind[N] == BTD::ENodeKind::VariableSet && G.NodeVar[N]) {
+                AddVarAnchor(VarWrites, G.Str(G.NodeVar[N]), NodeAnchor);
             }
 
-            if (const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(N)) {
-                const FName Var = GetNode->GetVarName();
-                if (!Var.IsNone()) AddVarAnchor(VarReads, Var.ToString(), NodeAnchor);
+            if (G.NodeKind[N] == BTD::ENodeKind::VariableGet && G.NodeVar[N]) {
+                AddVarAnchor(VarReads, G.Str(G.NodeVar[N]), NodeAnchor);
             }
 
-            if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(N)) {
-                const UFunction* Fn = Call->GetTargetFunction();
-                if (Fn) {
-                    FString Prop; bool bWrite = false;
-                    if (ExtractPropertyFromFunctionName(Fn->GetName(), Prop, bWrite)) {
-                        const FString ObjName = GetCallTargetObjectVarName(Call);
-                        if (!ObjName.IsEmpty()) {
-                            AddObjPropAnchor(Objects, ObjName, Prop, bWrite, NodeAnchor);
-                        }
+            if (G.NodeKind[N] == BTD::ENodeKind::CallFunction) {
+                // 속성 접근자 (SetXxx → write "Xxx", GetYyy → read "Yyy"): 캡처 시 함수 분류에서 추출됨
+                if (G.IsFunc(N, BTD::FC_PropertySetter | BTD::FC_PropertyGetter)) {
+                    const FString& ObjName = G.Str(G.CallTargetObjectVarName(N));
+                    if (!ObjName.IsEmpty()) {
+                        AddObjPropAnchor(Objects, ObjName, G.Str(G.NodeFuncProp[N]), G.IsFunc(N, BTD::FC_PropertySetter), NodeAnchor);
                     }
                 }
                 // 입력 핀에 물린 GET → 변수 read (소비자 기준 앵커도 NodeAnchor 사용)
-                for (UEdGraphPin* In : Call->Pins) {
-                    if (!IsDataInputPin(In)) continue;
-                    for (UEdGraphPin* L : In->LinkedTo) {
-                        if (!L || !L->GetOwningNode()) continue;
-                        if (const UK2Node_VariableGet* Get2 = Cast<UK2Node_VariableGet>(L->GetOwningNode())) {
-                            const FName V = Get2->GetVarName();
-                            if (!V.IsNone()) AddVarAnchor(VarReads, V.ToString(), NodeAnchor);
+                for (int32 In = G.NodeFirstPin[N], E = In + G.NodeNumPins[N]; In < E; ++In) {
+                    if (!G.IsDataInput(In)) continue;
+                    for (const int32 L : G.Links(In)) {
+                        const int32 Get2 = G.PinNode[L];
+                        if (G.NodeKind[Get2] == BTD::ENodeKind::VariableGet && G.NodeVar[Get2]) {
+                            AddVarAnchor(VarReads, G.Str(G.NodeVar[Get2]), NodeAnchor);
                         }
                     }
                 }
@@ -2295,63 +2504,69 @@ static void BuildDefUseForBP(
 
         }
     }
+}
 
+// --- Def–Use 파일 기록 (UObject 미사용, 워커 스레드 가능) ---
+static void WriteDefUseForBP(
+    const FString& BPName,
+    const FString& BPDir,
+    const FDefUseData& Data,
+    const FString& MetaFilePath,
+    const TArray<FString>& FlowJsonPaths,
+    BTD::FHashLedger& Ledger)
+{
+    const TMap<FString, FObjDefUse>& Objects = Data.Objects;
+    const TMap<FString, TSet<FString>>& VarWrites = Data.VarWrites;
+    const TMap<FString, TSet<FString>>& VarReads = Data.VarReads;
 
-    // --- JSON 빌드 ---
-    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
-    AddFrontMatter(Root); // ue_version, plugin_version
-    Root->SetStringField(TEXT("bp"), BP->GetName());
-
-    // hashes
-    {
-        TSharedRef<FJsonObject> H = MakeShared<FJsonObject>();
-        H->SetStringField(TEXT("bpmeta"), BTD::FileSHA256(MetaFilePath));
-        H->SetStringField(TEXT("bpflow"), BTD::MultiFileSHA256(FlowJsonPaths));
-        Root->SetObjectField(TEXT("hashes"), H);
-    }
-
-// objects
-    {
-        TSharedRef<FJsonObject> JObjs = MakeShared<FJsonObject>();
-        // Writes
-        for (const auto& KObj : Objects)
-        {
-            TSharedRef<FJsonObject> JOne = MakeShared<FJsonObject>();
-
-            // writes
-            {
-                TSharedRef<FJsonObject> JWrites = MakeShared<FJsonObject>();
-                for (const auto& KW : KObj.Value.Writes)
-                {
-                    TArray<TSharedPtr<FJsonValue>> Arr;
-                    for (const FString& S : KW.Value) Arr.Add(MakeShared<FJsonValueString>(S));
-                    JWrites->SetArrayField(KW.Key, Arr);
-                }
-                JOne->SetObjectField(TEXT("writes"), JWrites);
-            }
-
-            // reads
-            {
-                TSharedRef<FJsonObject> JReads = MakeShared<FJsonObject>();
-                for (const auto& KR : KObj.Value.Reads)
-                {
-                    TArray<TSharedPtr<FJsonValue>> Arr;
-                    for (const FString& S : KR.Value) Arr.Add(MakeShared<FJsonValueString>(S));
-                    JReads->SetArrayField(KR.Key, Arr);
-                }
-                JOne->SetObjectField(TEXT("reads"), JReads);
-            }
-
-            JObjs->SetObjectField(KObj.Key, JOne);
+    auto WriteAnchorMap = [](FJsonStreamWriter& JW, const TCHAR* Field, const TMap<FString, TSet<FString>>& Map)
+    {
+        JW.WriteObjectStart(Field);
+        for (const auto& K : Map)
+        {
+            JW.WriteArrayStart(K.Key);
+            for (const FString& S : K.Value) JW.WriteValue(S);
+            JW.WriteArrayEnd();
         }
-        Root->SetObjectField(TEXT("objects"), JObjs);
-    }
+        JW.WriteObjectEnd();
+    };
+
+    auto WriteAnchorSet = [](FJsonStreamWriter& JW, const TCHAR* Field, const TSet<FString>* Set)
+    {
+        JW.WriteArrayStart(Field);
+        if (Set)
+        {
+            for (const FString& A : *Set) JW.WriteValue(A);
+        }
+        JW.WriteArrayEnd();
+    };
+
+    // --- JSON 스트리밍 ---
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(*Json);
+    JW->WriteObjectStart();
+    WriteFrontMatter(*JW); // ue_version, plugin_version
+    JW->WriteValue(TEXT("bp"), BPName);
 
+    // hashes
+    JW->WriteObjectStart(TEXT("hashes"));
+    JW->WriteValue(TEXT("bpmeta"), Ledger.Get(MetaFilePath));
+    JW->WriteValue(TEXT("bpflow"), Ledger.Combined(FlowJsonPaths));
+    JW->WriteObjectEnd();
 
-// vars
+    // objects
+    JW->WriteObjectStart(TEXT("objects"));
+    for (const auto& KObj : Objects)
     {
-        TSharedRef<FJsonObject> JVars = MakeShared<FJsonObject>();
+        JW->WriteObjectStart(KObj.Key);
+        WriteAnchorMap(*JW, TEXT("writes"), KObj.Value.Writes);
+        WriteAnchorMap(*JW, TEXT("reads"), KObj.Value.Reads);
+        JW->WriteObjectEnd();
+    }
+    JW->WriteObjectEnd();
 
+    // vars
+    {
         TSet<FString> AllVarNames;
         for (const auto& K : VarWrites) AllVarNames.Add(K.Key);
         for (const auto& K : VarReads)  AllVarNames.Add(K.Key);
@@ -2359,45 +2574,23 @@ static void BuildDefUseForBP(
         TArray<FString> Names = AllVarNames.Array();
         Names.Sort();
 
+        JW->WriteObjectStart(TEXT("vars"));
         for (const FString& VName : Names)
         {
-            TSharedRef<FJsonObject> JV = MakeShared<FJsonObject>();
-
-            // writes
-            {
-                TArray<TSharedPtr<FJsonValue>> Arr;
-                if (const TSet<FString>* S = VarWrites.Find(VName))
-                {
-                    for (const FString& A : *S) Arr.Add(MakeShared<FJsonValueString>(A));
-                }
-                JV->SetArrayField(TEXT("writes"), Arr);
-            }
-
-            // reads
-            {
-                TArray<TSharedPtr<FJsonValue>> Arr;
-                if (const TSet<FString>* S = VarReads.Find(VName))
-                {
-                    for (const FString& A : *S) Arr.Add(MakeShared<FJsonValueString>(A));
-                }
-                JV->SetArrayField(TEXT("reads"), Arr);
-            }
-
-            JVars->SetObjectField(VName, JV);
+            JW->WriteObjectStart(VName);
+            WriteAnchorSet(*JW, TEXT("writes"), VarWrites.Find(VName));
+            WriteAnchorSet(*JW, TEXT("reads"), VarReads.Find(VName));
+            JW->WriteObjectEnd();
         }
-
-        Root->SetObjectField(TEXT("vars"), JVars);
+        JW->WriteObjectEnd();
     }
 
+    JW->WriteObjectEnd();
+    JW->Close();
 
     // --- 파일로 저장 ---
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    IFileManager::Get().MakeDirectory(*BPDir, true);
-
-    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpdefuse.json"), *BP->GetName()));
-    WriteJsonToFile(*Root, OutPath);
+    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpdefuse.json"), *BPName));
+    WriteUtf8ToFile(*Json, OutPath, Ledger);
 }
 
 
@@ -2420,44 +2613,36 @@ static FString TypeToFriendly(const FEdGraphPinType& T)
 }
 
 
+// 앞 단계(스냅샷/슬라이스/def-use)의 메모리 결과만으로 bpsmry.md 작성
 static void BuildAndWriteSummaryForBP(
-    UBlueprint* BP,
-    const TArray<TSharedPtr<FJsonValue>>& Slices,
+    const FBPDumpJob& Job,
+    const TArray<FFlowSlice>& Slices,
+    const FDefUseData& DefUse,
     const FString& MetaFilePath,
     const TArray<FString>& FlowJsonPaths,
-    const FString& OutRoot)
+    BTD::FHashLedger& Ledger)
 {
-    if (!BP) return;
+    const FString& BPName = Job.BPName;
+    const FString& ParentPath = Job.ParentPath;
+    const FString& BPDir = Job.BPDir;
+
     const FString UEVer = FEngineVersion::Current().ToString();
-    const FString MetaHash = BTD::FileSHA256(MetaFilePath);
-    const FString FlowHash = BTD::MultiFileSHA256(FlowJsonPaths);
-    const FString ParentPath = (BP->ParentClass) ? BP->ParentClass->GetPathName() : TEXT("");
+    const FString MetaHash = Ledger.Get(MetaFilePath);
+    const FString FlowHash = Ledger.Combined(FlowJsonPaths);
     const FString Timestamp = FDateTime::Now().ToIso8601();
 
-    // Derive file paths
-    const FString PkgPath = BP->GetOutermost()->GetName();
-    const FString PkgDir = FPaths::GetPath(PkgPath);
-    const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-    const FString CatalogPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BP->GetName()));
-    const FString DefUsePath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpdefuse.json"), *BP->GetName()));
-
-    // Load previously generated analysis
-    TSharedPtr<FJsonObject> JMeta = LoadJsonObject(MetaFilePath);
-    TSharedPtr<FJsonObject> JCatalog = LoadJsonObject(CatalogPath);
-    TSharedPtr<FJsonObject> JDefUse = LoadJsonObject(DefUsePath);
-
     // Entry points from catalog slices
-    TArray<FString> EntryIds; ExtractEntryPointsFromCatalog(JCatalog, EntryIds);
+    TArray<FString> EntryIds; ExtractEntryPointsFromSlices(Slices, EntryIds);
 
-    // Public API from per-graph flow jsons
+    // Public API from per-graph IR
     TArray<FPublicApiInfo> PublicApis;
-    ExtractPublicApisFromFlows(FlowJsonPaths, PublicApis);
+    ExtractPublicApisFromGraphs(Job.Graphs, PublicApis);
 
     // Top variables (by reads+writes) with friendly types from meta
-    TArray<FVarMeta> TopVars; ExtractVarUsage(JMeta, JDefUse, TopVars);
+    TArray<FVarMeta> TopVars; ExtractVarUsage(Job.MetaVars, DefUse, TopVars);
 
     // Dependencies (object var names) from defuse objects
-    TArray<FString> DependsOn; ExtractDependencies(JDefUse, DependsOn);
+    TArray<FString> DependsOn; ExtractDependencies(DefUse, DependsOn);
 
     // Role heuristic
     FString Role;
@@ -2469,13 +2654,15 @@ static void BuildAndWriteSummaryForBP(
         Role = TEXT("게임플레이 로직을 포함한 **블루프린트 클래스**.");
 
     // Build markdown
-    FString MD;
+    BTD::FScopedUtf8Builder MDBuf;
+    BeginTextArtifact(*MDBuf, TEXT(".md"));
+    BTD::FUtf8Builder& MD = *MDBuf;
     MD += TEXT("---\n");
-    MD += FString::Printf(TEXT("bp: %s\n"), *BP->GetName());
-    MD += FString::Printf(TEXT("parent: %s\n"), *ParentPath);
-    MD += FString::Printf(TEXT("ue_version: %s\n"), *UEVer);
-    MD += FString::Printf(TEXT("hashes: { bpmeta: %s, bpflow: %s }\n"), *MetaHash, *FlowHash);
-    MD += FString::Printf(TEXT("generated_at: %s\n"), *Timestamp);
+    MD.Appendf(TEXT("bp: %s\n"), *BPName);
+    MD.Appendf(TEXT("parent: %s\n"), *ParentPath);
+    MD.Appendf(TEXT("ue_version: %s\n"), *UEVer);
+    MD.Appendf(TEXT("hashes: { bpmeta: %s, bpflow: %s }\n"), *MetaHash, *FlowHash);
+    MD.Appendf(TEXT("generated_at: %s\n"), *Timestamp);
     MD += TEXT("---\n\n");
 
     MD += TEXT("## Role\n");
@@ -2491,7 +2678,7 @@ static void BuildAndWriteSummaryForBP(
         for (const FString& Id : EntryIds)
         {
             const FString Label = NormalizeEventIdForLabel(Id);
-            MD += FString::Printf(TEXT("- **%s**: (see: `%s`)\n"), *Label, *Id);
+            MD.Appendf(TEXT("- **%s**: (see: `%s`)\n"), *Label, *Id);
         }
         MD += TEXT("\n");
     }
@@ -2520,7 +2707,7 @@ static void BuildAndWriteSummaryForBP(
         for (const FVarMeta& V : TopVars)
         {
             const FString Ty = FriendlyFromCategory(V.Cat, V.Sub);
-            MD += FString::Printf(TEXT("- `%s` (%s)\n"), *V.Name, *Ty);
+            MD.Appendf(TEXT("- `%s` (%s)\n"), *V.Name, *Ty);
         }
         MD += TEXT("\n");
     }
@@ -2555,9 +2742,8 @@ static void BuildAndWriteSummaryForBP(
         MD += TEXT("- flow.") + Slugged + TEXT("\n");
     }
 
-    IFileManager::Get().MakeDirectory(*BPDir, true);
-    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpsmry.md"), *BP->GetName()));
-    WriteTextToFile(MD, OutPath);
+    const FString OutPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpsmry.md"), *BPName));
+    WriteUtf8ToFile(MD, OutPath, Ledger);
 
 }
 
@@ -2567,14 +2753,14 @@ void FBPTextDumpModule::StartupModule()
 
     DumpAllCmd = CM.RegisterConsoleCommand(
         TEXT("BP.DumpAll"),
-        TEXT("Dump Blueprint graphs. Optional: Root=/Game/Subfolder Out=C:/path"),
+        TEXT("Dump Blueprint graphs. Optional: Root=/Game/Subfolder Out=C:/path Jobs=N (N>1: pipelined workers) Prefetch=N (async load window, 0=off) MemBudgetMB=N (GC when resident memory exceeds N MB) Shard=i/N Force (ignore manifest)"),
         FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdDumpAll),
         ECVF_Cheat
     );
 
     DumpSelCmd = CM.RegisterConsoleCommand(
         TEXT("BP.DumpSelected"),
-        TEXT("Dump selected Blueprints from the Content Browser. Optional: Out=C:/path"),
+        TEXT("Dump selected Blueprints from the Content Browser. Optional: Out=C:/path Root=/Game/A,/Game/B Prefetch=N"),
         FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdDumpSelected),
         ECVF_Cheat
     );
@@ -2587,17 +2773,42 @@ void FBPTextDumpModule::StartupModule()
     );
     ProjectRefsCmd = CM.RegisterConsoleCommand(
         TEXT("BP.ProjectRefs"),
-        TEXT("Build project-wide reference graph. Optional: Root=/Game Sub=/Game/UI Out=C:/path"),
+        TEXT("Build project-wide reference graph. Optional: Root=/Game Sub=/Game/UI Out=C:/path Prefetch=N MemBudgetMB=N Shard=i/N (writes a per-shard graph, see BP.MergeShards) RefsOnly (do not re-dump changed BPs) Store (also write project_graph.btdstore for BP.Query) Facts (also write project_facts.btdfacts for BP.Facts) Force (ignore manifest)"),
         FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdProjectRefs),
         ECVF_Cheat
          );
+    MergeShardsCmd = CM.RegisterConsoleCommand(
+        TEXT("BP.MergeShards"),
+        TEXT("Merge per-shard graphs from BP.ProjectRefs Shard=i/N into project_references.json. Optional: Out=C:/path Shards=N"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdMergeShards),
+        ECVF_Cheat
+    );
+
+    QueryCmd = CM.RegisterConsoleCommand(
+        TEXT("BP.Query"),
+        TEXT("Search the graph store written by BP.ProjectRefs Store. Args: Calls=Func | Reads=Var | Writes=Var | Var=Var. Optional: Out=C:/path Limit=N"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdQuery),
+        ECVF_Cheat
+    );
+
+    FactsCmd = CM.RegisterConsoleCommand(
+        TEXT("BP.Facts"),
+        TEXT("Look up facts in the project fact DB written by BP.ProjectRefs Facts. Args: any of S=Subject P=predicate O=Object. Optional: Out=C:/path Limit=N"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FBPTextDumpModule::CmdFacts),
+        ECVF_Cheat
+    );
+
+    BTD::StartArtifactWriter();
 
-    RegisterMenus();
+    // 커맨드렛(-run=BPTextDump)에서는 Slate/메뉴가 없음
+    if (!IsRunningCommandlet())
+        RegisterMenus();
 }
 
 
 void FBPTextDumpModule::ShutdownModule()
 {
+    BTD::StopArtifactWriter(); // 남은 기록 flush
     if (DumpAllCmd)
     {
         IConsoleManager::Get().UnregisterConsoleObject(DumpAllCmd);
@@ -2618,21 +2829,57 @@ void FBPTextDumpModule::ShutdownModule()
         IConsoleManager::Get().UnregisterConsoleObject(ProjectRefsCmd);
         ProjectRefsCmd = nullptr;
         }
+    if (MergeShardsCmd)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(MergeShardsCmd);
+        MergeShardsCmd = nullptr;
+    }
+    if (QueryCmd)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(QueryCmd);
+        QueryCmd = nullptr;
+    }
+    if (FactsCmd)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(FactsCmd);
+        FactsCmd = nullptr;
+    }
     UnregisterMenus();
 }
 
 void FBPTextDumpModule::CmdDumpAll(const TArray<FString>& Args)
+{
+    RunDumpAll(Args);
+}
+
+EBPTextDumpResult FBPTextDumpModule::RunDumpAll(const TArray<FString>& Args)
 {
     FString RootPath = TEXT("/Game");
     FString OutRoot = DefaultOutDir();
+    int32 Jobs = 1;
+    int32 PrefetchWindow = DefaultPrefetchWindow();
+    int32 MemBudgetMB = 0;
+    FShardSpec Shard;
+    bool bShardValid = true;
+    bool bForce = false;
 
     for (const FString& A : Args)
     {
         if (A.StartsWith(TEXT("Root="))) RootPath = A.RightChop(5);
         else if (A.StartsWith(TEXT("Out="))) OutRoot = A.RightChop(4);
+        else if (A.StartsWith(TEXT("Jobs="))) Jobs = FMath::Clamp(FCString::Atoi(*A.RightChop(5)), 1, 64);
+        else if (ParsePrefetchArg(A, PrefetchWindow)) {}
+        else if (ParseMemBudgetArg(A, MemBudgetMB)) {}
+        else if (ParseShardArg(A, Shard, bShardValid)) {}
+        else if (IsForceArg(A)) bForce = true;
     }
+    if (!bShardValid) return EBPTextDumpResult::BadArguments;
 
-    IFileManager::Get().MakeDirectory(*OutRoot, /*Tree*/ true);
+    if (!IFileManager::Get().MakeDirectory(*OutRoot, /*Tree*/ true))
+    {
+        UE_LOG(LogTemp, Error, TEXT("BPTextDump: Cannot create output directory %s"), *OutRoot);
+        return EBPTextDumpResult::Failed;
+    }
 
     FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
     FARFilter Filter;
@@ -2645,24 +2892,99 @@ void FBPTextDumpModule::CmdDumpAll(const TArray<FString>& Args)
     ARM.Get().GetAssets(Filter, Assets);
 
     UE_LOG(LogTemp, Display, TEXT("BPTextDump: Found %d Blueprint assets under %s"), Assets.Num(), *RootPath);
+    Shard.Filter(Assets, TEXT("BPTextDump"));
 
-    int32 DumpedGraphs = 0;
-    int32 DumpedAssets = 0;
-    for (const FAssetData& AD : Assets)
+    std::atomic<int32> DumpedGraphs{ 0 };
+    std::atomic<int32> DumpedAssets{ 0 };
+    int32 LoadFailed = 0;
+    ResetDumpStats();
+    BTD::OutputStats().Reset();
+
+    // Jobs>1: 게임 스레드는 스냅샷만, 산출물 생성/기록은 워커가 담당 (큐 크기 = Jobs*2)
+    TUniquePtr<BTD::FDumpPipeline> Pipeline;
+    if (Jobs > 1)
+    {
+        PluginVersion(); // 게임 스레드에서 미리 캐시
+        Pipeline = MakeUnique<BTD::FDumpPipeline>(Jobs, Jobs * 2);
+    }
+
+    // 증분: 변경 키가 같은 패키지는 로드 없이 건너뜀 (Force면 전부 덤프)
+    FDumpManifest Manifest;
+    Manifest.Suffix = Shard.Suffix();
+    Manifest.Load(OutRoot);
+
+    // 1차: 변경된 패키지만 골라둠 (로드 대상 목록 = prefetch 순서)
+    TArray<int32> ToDump;
+    TArray<FString> ChangeKeys;
+    TArray<FName> ToLoad;
+    for (int32 i = 0; i < Assets.Num(); ++i)
+    {
+        FString ChangeKey = ChangeKeyForAsset(Assets[i]);
+        if (!bForce && Manifest.IsUpToDate(Assets[i], ChangeKey, OutRoot)) { ++Manifest.Skipped; continue; }
+        ToDump.Add(i);
+        ChangeKeys.Add(MoveTemp(ChangeKey));
+        ToLoad.Add(Assets[i].PackageName);
+    }
+
+    // 2차: 현재 BP를 덤프하는 동안 다음 PrefetchWindow개 패키지를 비동기로 로드
+    // 잡은 UObject를 들고 있지 않으므로 GC 전에 파이프라인을 비울 필요 없음
+    BTD::FPackagePrefetcher Prefetch(MoveTemp(ToLoad), PrefetchWindow);
+    BTD::FMemoryBudget MemBudget(MemBudgetMB, TEXT("BPTextDump"));
+    MemBudget.SetKeepAlive([&Prefetch](TSet<FName>& Keep) { Prefetch.GetPackagesAhead(Keep); }); // 미리 로드한 창은 GC하지 않음
+    for (int32 k = 0; k < ToDump.Num(); ++k)
+    {
+        const FAssetData& AD = Assets[ToDump[k]];
+        Prefetch.WaitFor(k);
+
+        TUniquePtr<FBPDumpJob> Job;
+        if (UBlueprint* BP = Cast<UBlueprint>(AD.GetAsset()))
+            Job = SnapshotBlueprint(BP, OutRoot);
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("BPTextDump: Failed to load %s"), *AD.GetObjectPathString());
+            ++LoadFailed;
+        }
+        if (!Job) { MemBudget.Tick(); continue; }
+        Manifest.Record(AD, ChangeKeys[k]);
+
+        auto Emit = [Job = MoveTemp(Job), &DumpedGraphs, &DumpedAssets]()
+            {
+                const int32 N = EmitBlueprintJob(*Job);
+                if (N > 0) { ++DumpedAssets; DumpedGraphs += N; }
+            };
+        if (Pipeline) Pipeline->Submit(MoveTemp(Emit));
+        else          Emit();
+        Prefetch.Pump(PrefetchPumpSeconds);
+        MemBudget.Tick();
+    }
+
+    if (Pipeline)
     {
-        UBlueprint* BP = Cast<UBlueprint>(AD.GetAsset());
-        if (!BP) continue;
-        const int32 N = DumpBlueprintToDir(BP, OutRoot);
-        if (N > 0) { ++DumpedAssets; DumpedGraphs += N; }
+        Pipeline->Drain();
+        UE_LOG(LogTemp, Display, TEXT("BPTextDump: pipeline Jobs=%d, %d jobs, max queue depth %d, snapshot stalled %.2fs"),
+            Pipeline->GetNumWorkers(), Pipeline->GetSubmitted(), Pipeline->GetMaxDepth(), Pipeline->GetStallSeconds());
+        Pipeline.Reset();
     }
 
-    UE_LOG(LogTemp, Display, TEXT("BPTextDump: Wrote %d graph files from %d assets to %s"), DumpedGraphs, DumpedAssets, *OutRoot);
+    Manifest.SaveIfWritten(OutRoot, TEXT("BPTextDump"));
+
+    UE_LOG(LogTemp, Display, TEXT("BPTextDump: Wrote %d graph files from %d assets to %s (%d unchanged skipped)"),
+        DumpedGraphs.load(), DumpedAssets.load(), *OutRoot, Manifest.Skipped);
+    Prefetch.Log(TEXT("BPTextDump"));
+    MemBudget.Log();
+    LogDumpStats();
+    BTD::FlushArtifacts();
+    BTD::OutputStats().Log(TEXT("BP.DumpAll"));
+    return (LoadFailed == 0 && BTD::OutputStats().Failed.load() == 0) ? EBPTextDumpResult::Ok : EBPTextDumpResult::Failed;
 }
 
 void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
 {
     FString OutRoot = DefaultOutDir();
     TArray<FString> RootArgs; // 선택이 없을 때 스캔할 루트 경로들
+    int32 PrefetchWindow = DefaultPrefetchWindow();
+    ResetDumpStats();
+    BTD::OutputStats().Reset();
 
     for (const FString& A : Args)
     {
@@ -2673,6 +2995,7 @@ void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
             const FString Raw = A.RightChop(5);
             Raw.ParseIntoArray(RootArgs, TEXT(","), true);
         }
+        else ParsePrefetchArg(A, PrefetchWindow);
     }
     IFileManager::Get().MakeDirectory(*OutRoot, true);
 
@@ -2690,21 +3013,36 @@ void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
     // 우선 선택 자산을 처리
     int32 AssetCount = 0, GraphCount = 0;
 
-    auto ProcessAsset = [&](const FAssetData& AD)
+    // BP만 추려서, 현재 BP를 덤프하는 동안 다음 패키지들을 비동기로 미리 로드
+    auto ProcessAssets = [&](const TArray<FAssetData>& List)
         {
-            bool bBP = false;
-            if (UClass* C = AD.GetClass()) bBP = C->IsChildOf(UBlueprint::StaticClass());
-            else                           bBP = AD.AssetClassPath.ToString().EndsWith(TEXT("Blueprint"));
-            if (!bBP) return;
+            TArray<const FAssetData*> BPs;
+            TArray<FName> ToLoad;
+            for (const FAssetData& AD : List)
+            {
+                bool bBP = false;
+                if (UClass* C = AD.GetClass()) bBP = C->IsChildOf(UBlueprint::StaticClass());
+                else                           bBP = AD.AssetClassPath.ToString().EndsWith(TEXT("Blueprint"));
+                if (!bBP) continue;
+                BPs.Add(&AD);
+                ToLoad.Add(AD.PackageName);
+            }
 
-            if (UBlueprint* BP = Cast<UBlueprint>(AD.GetAsset()))
+            BTD::FPackagePrefetcher Prefetch(MoveTemp(ToLoad), PrefetchWindow);
+            for (int32 k = 0; k < BPs.Num(); ++k)
             {
-                ++AssetCount;
-                GraphCount += DumpBlueprintToDir(BP, OutRoot);
+                Prefetch.WaitFor(k);
+                if (UBlueprint* BP = Cast<UBlueprint>(BPs[k]->GetAsset()))
+                {
+                    ++AssetCount;
+                    GraphCount += DumpBlueprintToDir(BP, OutRoot);
+                }
+                Prefetch.Pump(PrefetchPumpSeconds);
             }
+            Prefetch.Log(TEXT("BP.DumpSelected"));
         };
 
-    for (const FAssetData& AD : SelectedAssets) ProcessAsset(AD);
+    ProcessAssets(SelectedAssets);
 
     // 선택 폴더 fallback
     if (AssetCount == 0 && SelectedFolders.Num() > 0)
@@ -2718,7 +3056,7 @@ void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
 
         TArray<FAssetData> Assets; ARM.Get().GetAssets(Filter, Assets);
         UE_LOG(LogTemp, Display, TEXT("Fallback by folders: found %d Blueprint assets"), Assets.Num());
-        for (const FAssetData& AD : Assets) ProcessAsset(AD);
+        ProcessAssets(Assets);
     }
 
     // 선택이 전혀 없거나 폴더에도 없으면 → Root 인자 사용
@@ -2733,7 +3071,7 @@ void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
 
         TArray<FAssetData> Assets; ARM.Get().GetAssets(Filter, Assets);
         UE_LOG(LogTemp, Display, TEXT("Fallback by Root args: found %d Blueprint assets"), Assets.Num());
-        for (const FAssetData& AD : Assets) ProcessAsset(AD);
+        ProcessAssets(Assets);
     }
 
     // 그래도 0이면 → 설정 기본 루트 또는 /Game 스캔
@@ -2753,11 +3091,14 @@ void FBPTextDumpModule::CmdDumpSelected(const TArray<FString>& Args)
         TArray<FAssetData> Assets; ARM.Get().GetAssets(Filter, Assets);
         UE_LOG(LogTemp, Display, TEXT("Fallback by default root (%s): found %d Blueprint assets"),
             *DefaultRoot, Assets.Num());
-        for (const FAssetData& AD : Assets) ProcessAsset(AD);
+        ProcessAssets(Assets);
     }
 
     UE_LOG(LogTemp, Display, TEXT("Selected %d BPs, wrote %d graph files to %s"),
         AssetCount, GraphCount, *OutRoot);
+    LogDumpStats();
+    BTD::FlushArtifacts();
+    BTD::OutputStats().Log(TEXT("BP.DumpSelected"));
 }
 
 
@@ -2780,8 +3121,12 @@ void FBPTextDumpModule::CmdDumpOne(const TArray<FString>& Args)
     UBlueprint* BP = Cast<UBlueprint>(Loaded);
     if (!BP) { UE_LOG(LogTemp, Error, TEXT("BP.DumpOne: Failed to load %s"), *ObjPath); return; }
 
+    BTD::FClassHierarchyCache::Get().Reset(); // 에디터에서 재컴파일된 클래스가 있을 수 있음
+    BTD::OutputStats().Reset();
     const int32 N = DumpBlueprintToDir(BP, OutRoot);
     UE_LOG(LogTemp, Display, TEXT("BPTextDump: Wrote %d graph files for %s to %s"), N, *ObjPath, *OutRoot);
+    BTD::FlushArtifacts();
+    BTD::OutputStats().Log(TEXT("BP.DumpOne"));
 }
 
 // 편의: UI 액션들
@@ -2814,6 +3159,7 @@ void FBPTextDumpModule::UI_DumpSelected()
     FContentBrowserModule& CB = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
     TArray<FAssetData> Selected; CB.Get().GetSelectedAssets(Selected);
 
+    BTD::FClassHierarchyCache::Get().Reset();
     int32 AssetCount = 0, GraphCount = 0;
     for (const FAssetData& AD : Selected)
     {
@@ -2900,6 +3246,228 @@ void FBPTextDumpModule::RegisterMenus_Impl()
     }
 }
 
+// ============================================================
+// Project-Wide Reference Analysis — shared helpers
+// ============================================================
+struct FProjectRefAsset
+{
+    FString PkgPath;        // "/Game/Path/Asset"
+    FString AssetType;      // "Blueprint" | "WidgetBlueprint"
+    FString GenClassName;   // "Asset_C"
+};
+
+// 로드 없이 레지스트리 정보만으로 (미변경 자산, 다른 샤드 자산)
+static FProjectRefAsset ProjectRefAssetFromRegistry(const FAssetData& AD)
+{
+    FProjectRefAsset Info;
+    Info.PkgPath = AD.PackageName.ToString();
+    const UClass* AssetClass = AD.GetClass();
+    Info.AssetType = (AssetClass && AssetClass->IsChildOf<UWidgetBlueprint>()) ? TEXT("WidgetBlueprint") : TEXT("Blueprint");
+    FString GenPath;
+    if (AD.GetTagValue(FBlueprintTags::GeneratedClassPath, GenPath))
+        Info.GenClassName = FPackageName::ObjectPathToObjectName(FPackageName::ExportTextPathToObjectPath(GenPath));
+    return Info;
+}
+
+static FString ShardReferencesPath(const FString& OutRoot, int32 Index, int32 Count)
+{
+    return FPaths::Combine(OutRoot, FString::Printf(TEXT("project_references.shard-%d-of-%d.json"), Index, Count));
+}
+
+static void WriteRefRow(FJsonStreamWriter& JW, const TCHAR* Field, const BTD::FRefGraph& Graph, TConstArrayView<int32> Row)
+{
+    JW.WriteArrayStart(Field);
+    for (const int32 Id : Row) JW.WriteValue(Graph.Key(Id));
+    JW.WriteArrayEnd();
+}
+
+static FString ProjectGraphStorePath(const FString& OutRoot)
+{
+    return FPaths::Combine(OutRoot, TEXT("project_graph.btdstore"));
+}
+
+// BP별 <BP>.bpstore 조각을 project_graph.btdstore 하나로 합침 (BP.Query용)
+// InMemory: RefsOnly로 산출물을 쓰지 않은 자산의 조각 (All 인덱스 → 바이트)
+static bool WriteProjectGraphStore(const FString& OutRoot, const TArray<FProjectRefAsset>& Assets,
+    const TMap<int32, TArray<uint8>>& InMemory)
+{
+    const double T0 = FPlatformTime::Seconds();
+    BTD::FGraphStoreWriter Store;
+    int32 Missing = 0;
+    for (int32 i = 0; i < Assets.Num(); ++i)
+    {
+        TArray<uint8> Bytes;
+        if (const TArray<uint8>* Mem = InMemory.Find(i)) Bytes = *Mem;
+        else
+        {
+            const FString& PkgPath = Assets[i].PkgPath;
+            const FString BPDir = FPaths::Combine(OutRoot, FPaths::GetPath(PkgPath));
+            BTD::LoadArtifact(FragmentPathFor(BPDir, FPaths::GetCleanFilename(PkgPath)), Bytes); // 큐에 남은 기록도 보임
+        }
+
+        BTD::FGraphFragment F;
+        if (Bytes.Num() == 0 || !BTD::LoadGraphFragment(Bytes, F))
+        {
+            ++Missing;
+            continue;
+        }
+        Store.Add(F);
+    }
+
+    TArray<uint8> Out;
+    Store.Finish(Out);
+    const FString Path = ProjectGraphStorePath(OutRoot);
+    const bool bOk = BTD::WriteArtifact(Path, MoveTemp(Out));
+    UE_LOG(LogTemp, Display, TEXT("BP.ProjectRefs: graph store %s: %d blueprints, %d nodes (%.3fs)"),
+        *Path, Store.NumBlueprints(), Store.NumNodes(), FPlatformTime::Seconds() - T0);
+    if (Missing > 0)
+        UE_LOG(LogTemp, Warning, TEXT("BP.ProjectRefs: %d blueprints have no (or an outdated) .bpstore fragment; run once with Force to include them"), Missing);
+    return bOk;
+}
+
+static FString ProjectFactStorePath(const FString& OutRoot)
+{
+    return FPaths::Combine(OutRoot, TEXT("project_facts.btdfacts"));
+}
+
+// 모든 BP의 fact를 project_facts.btdfacts 하나로 합침 (BP.Facts용)
+// InMemory: RefsOnly로 bpfacts.ndjson을 쓰지 않은 자산의 fact (All 인덱스 → 테이블)
+static bool WriteProjectFactStore(const FString& OutRoot, const TArray<FProjectRefAsset>& Assets,
+    const TMap<int32, BTD::FFactTable>& InMemory)
+{
+    const double T0 = FPlatformTime::Seconds();
+    BTD::FFactStoreWriter Store;
+    int32 Missing = 0;
+    for (int32 i = 0; i < Assets.Num(); ++i)
+    {
+        const FString& PkgPath = Assets[i].PkgPath;
+        Store.BeginBlueprint(PkgPath);
+        if (const BTD::FFactTable* Mem = InMemory.Find(i))
+        {
+            TArray<int32, TInlineAllocator<8>> Ev;
+            for (int32 F = 0; F < Mem->Num(); ++F)
+            {
+                const BTD::FFactTable::FFact& Fact = (*Mem)[F];
+                Mem->SortedEvidence(Fact, Ev);
+                Store.Add(Mem->Str(Fact.S), Mem->Str(Fact.P), Mem->Str(Fact.O), Ev.Num() > 0 ? Mem->Str(Ev[0]) : FString());
+            }
+            continue;
+        }
+
+        const FString BPDir = FPaths::Combine(OutRoot, FPaths::GetPath(PkgPath));
+        const bool bFound = BTD::ForEachFactLine(FactsPathFor(BPDir, FPaths::GetCleanFilename(PkgPath)), [&](const BTD::FFactView& F)
+            {
+                Store.Add(BTD::ToFString(F.S), BTD::ToFString(F.P), BTD::ToFString(F.O), BTD::ToFString(F.Ev));
+            });
+        if (!bFound) ++Missing;
+    }
+
+    TArray<uint8> Out;
+    Store.Finish(Out);
+    const FString Path = ProjectFactStorePath(OutRoot);
+    const bool bOk = BTD::WriteArtifact(Path, MoveTemp(Out));
+    UE_LOG(LogTemp, Display, TEXT("BP.ProjectRefs: fact store %s: %d blueprints, %d facts (%.3fs)"),
+        *Path, Store.NumBlueprints(), Store.NumFacts(), FPlatformTime::Seconds() - T0);
+    if (Missing > 0)
+        UE_LOG(LogTemp, Warning, TEXT("BP.ProjectRefs: %d blueprints have no bpfacts.ndjson"), Missing);
+    return bOk;
+}
+
+// project_references.json 본문 (스트리밍). bReferencedBy=false면 references_to만 (샤드 부분 그래프)
+// Graph는 Build() 완료 상태, 행은 이미 키 순서로 정렬되어 있음
+static void WriteProjectReferences(const FString& OutPath, const TArray<FProjectRefAsset>& Assets,
+    const BTD::FRefGraph& Graph, bool bReferencedBy, const FShardSpec* Shard = nullptr)
+{
+    BTD::FScopedUtf8Builder Json;
+    TSharedRef<FJsonStreamWriter> JW = MakeJsonStreamWriter(*Json);
+    JW->WriteObjectStart();
+    JW->WriteValue(TEXT("project_name"), FString(FApp::GetProjectName()));
+    JW->WriteValue(TEXT("analysis_timestamp"), FDateTime::Now().ToIso8601());
+    JW->WriteObjectStart(TEXT("assets"));
+    for (const FProjectRefAsset& It : Assets)
+    {
+        const int32 Id = Graph.Find(It.PkgPath);
+        JW->WriteObjectStart(It.PkgPath);
+        JW->WriteValue(TEXT("asset_type"), It.AssetType);
+        WriteRefRow(*JW, TEXT("references_to"), Graph, Graph.Out(Id));
+        if (bReferencedBy)
+            WriteRefRow(*JW, TEXT("referenced_by"), Graph, Graph.In(Id));
+        JW->WriteObjectEnd();
+    }
+    JW->WriteObjectEnd();
+    if (Shard)
+    {
+        JW->WriteObjectStart(TEXT("shard"));
+        JW->WriteValue(TEXT("index"), double(Shard->Index));
+        JW->WriteValue(TEXT("count"), double(Shard->Count));
+        JW->WriteObjectEnd();
+    }
+    JW->WriteObjectEnd();
+    JW->Close();
+    WriteUtf8ToFile(*Json, OutPath);
+}
+
+// bprefs.json이 없는 이전 버전 산출물: bpmeta / bpcatalog / bpflow / bpfacts에서 레퍼런스 후보 복원
+static void CollectRefsFromArtifacts(const FString& BPDir, const FString& BaseName, FAssetRefSet& Out)
+{
+    // bpmeta.json
+    const FString MetaPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *BaseName));
+    if (TSharedPtr<FJsonObject> JM = LoadJsonObject(MetaPath))
+    {
+        FString ParentPath;
+        if (JM->TryGetStringField(TEXT("bp_parent_class_path"), ParentPath))
+            Out.AddPath(ParentPath);
+        const TArray<TSharedPtr<FJsonValue>>* Ifaces = nullptr;
+        if (JM->TryGetArrayField(TEXT("implemented_interfaces"), Ifaces))
+        {
+            for (const auto& V : *Ifaces)
+            {
+                FString P; if (V->TryGetString(P)) Out.AddPath(P);
+            }
+        }
+    }
+
+    // bpcatalog.json -> 그래프 목록
+    const FString CatalogPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BaseName));
+    TArray<FString> GraphNames;
+    if (TSharedPtr<FJsonObject> JC = LoadJsonObject(CatalogPath))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* GArr = nullptr;
+        if (JC->TryGetArrayField(TEXT("graphs"), GArr))
+        {
+            for (const auto& V : *GArr) { FString N; if (V->TryGetString(N)) GraphNames.Add(N); }
+        }
+    }
+
+    // 각 graph의 bpflow.json: 핀 기본 오브젝트 경로
+    for (const FString& GName : GraphNames)
+    {
+        const FString FlowPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__%s.bpflow.json"), *BaseName, *GName));
+        TSharedPtr<FJsonObject> JF = LoadJsonObject(FlowPath);
+        const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+        if (!JF.IsValid() || !JF->TryGetArrayField(TEXT("nodes"), Nodes)) continue;
+        for (const auto& NV : *Nodes)
+        {
+            const TSharedPtr<FJsonObject>* NObj = nullptr; if (!NV->TryGetObject(NObj)) continue;
+            const TArray<TSharedPtr<FJsonValue>>* Pins = nullptr;
+            if (!(*NObj)->TryGetArrayField(TEXT("pins"), Pins)) continue;
+            for (const auto& PV : *Pins)
+            {
+                const TSharedPtr<FJsonObject>* PObj = nullptr; if (!PV->TryGetObject(PObj)) continue;
+                FString DOP;
+                if ((*PObj)->TryGetStringField(TEXT("default_object_path"), DOP))
+                    Out.AddPath(DOP);
+            }
+        }
+    }
+
+    // bpfacts.ndjson: fact의 o 값 (스트리밍, 고정 스키마 줄은 DOM 없이)
+    BTD::ForEachFactLine(FactsPathFor(BPDir, BaseName), [&](const BTD::FFactView& F)
+        {
+            if (!F.O.IsEmpty()) Out.AddFactObject(BTD::ToFString(F.O));
+        });
+}
+
 // ============================================================
 // Project-Wide Reference Analysis — command handlers
 // ============================================================
@@ -2917,191 +3485,426 @@ void FBPTextDumpModule::UI_BuildProjectRefs()
 }
 
 void FBPTextDumpModule::CmdProjectRefs(const TArray<FString>& Args)
+{
+    RunProjectRefs(Args);
+}
+
+EBPTextDumpResult FBPTextDumpModule::RunProjectRefs(const TArray<FString>& Args)
 {
     // Args: Root=/Game[,/Plugin/Content] Out=C:/path
     TArray<FString> Roots; Roots.Add(TEXT("/Game"));
     FString OutRoot = DefaultOutDir();
+    int32 PrefetchWindow = DefaultPrefetchWindow();
+    int32 MemBudgetMB = 0;
+    FShardSpec Shard;
+    bool bShardValid = true;
+    bool bForce = false;
+    bool bRefsOnly = false;
+    bool bStore = false;
+    bool bFactStore = false;
     for (const FString& A : Args)
     {
         if (A.StartsWith(TEXT("Root="))) { Roots.Reset(); A.Mid(5).ParseIntoArray(Roots, TEXT(","), true); }
         else if (A.StartsWith(TEXT("Out="))) OutRoot = A.Mid(4);
+        else if (ParsePrefetchArg(A, PrefetchWindow)) {}
+        else if (ParseMemBudgetArg(A, MemBudgetMB)) {}
+        else if (ParseShardArg(A, Shard, bShardValid)) {}
+        else if (A.Equals(TEXT("RefsOnly"), ESearchCase::IgnoreCase)) bRefsOnly = true;
+        else if (A.Equals(TEXT("Store"), ESearchCase::IgnoreCase)) bStore = true;
+        else if (A.Equals(TEXT("Facts"), ESearchCase::IgnoreCase)) bFactStore = true;
+        else if (IsForceArg(A)) bForce = true;
+    }
+    if (!bShardValid) return EBPTextDumpResult::BadArguments;
+    if ((bStore || bFactStore) && Shard.IsSharded())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BP.ProjectRefs: Store/Facts are ignored for Shard=; run them on the unsharded (or merged) output"));
+        bStore = bFactStore = false;
+    }
+    if (!IFileManager::Get().MakeDirectory(*OutRoot, true))
+    {
+        UE_LOG(LogTemp, Error, TEXT("BP.ProjectRefs: Cannot create output directory %s"), *OutRoot);
+        return EBPTextDumpResult::Failed;
     }
-    IFileManager::Get().MakeDirectory(*OutRoot, true);
 
-    // 1) 인벤토리: 모든 BP 로드, 이름 인덱스 생성, 팩 생성 보장
+    // 1) 인벤토리: 변경된 BP만 로드, 이름 인덱스 생성, 팩 생성 보장
     FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
     FARFilter Filter; Filter.bRecursivePaths = true; Filter.bRecursiveClasses = true;
     Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
     for (const FString& R : Roots) Filter.PackagePaths.Add(*R);
     TArray<FAssetData> Assets; ARM.Get().GetAssets(Filter, Assets);
 
-    struct FAssetInfo {
-        FString PkgPath;        // "/Game/Path/Asset"
-        FString AssetType;      // "Blueprint" | "WidgetBlueprint"
-        FString GenClassName;   // "Asset_C"
-    };
-    TArray<FAssetInfo> All;
-    TMap<FString, FString> NameToAssetKey; // "BP_Foo" -> "/Game/.../BP_Foo", "BP_Foo_C" -> same
+    TArray<FProjectRefAsset> All;
+    BTD::FRefGraph Graph;            // 자산 키 → 정수 id, 간선은 CSR로 압축
+    TMap<FString, int32> NameToId;   // "BP_Foo" -> id("/Game/.../BP_Foo"), "BP_Foo_C" -> same
+    auto AddNames = [&](const FAssetData& AD, const FProjectRefAsset& Info)
+        {
+            const FString PkgKey = ToAssetKeyFromClassPath(Info.PkgPath);
+            if (PkgKey.IsEmpty()) return; // /Game, /Script 밖의 경로는 키가 없음
+            const int32 Id = Graph.Intern(PkgKey);
+            NameToId.Add(AD.AssetName.ToString(), Id); // package key
+            if (!Info.GenClassName.IsEmpty())
+                NameToId.Add(Info.GenClassName, Id);
+        };
 
-    for (const FAssetData& AD : Assets)
+    // 샤드 실행: 이름 인덱스는 전체 목록(레지스트리 정보)으로 채워 다른 샤드 자산으로의 참조도 해석
+    if (Shard.IsSharded())
     {
-        UBlueprint* BP = Cast<UBlueprint>(AD.GetAsset());
-        if (!BP) continue;
-        // ensure packs
-        DumpBlueprintToDir(BP, OutRoot);
-
-        FAssetInfo Info;
-        Info.PkgPath = BP->GetOutermost()->GetName(); // "/Game/.../Asset"
-        Info.AssetType = BP->IsA<UWidgetBlueprint>() ? TEXT("WidgetBlueprint") : TEXT("Blueprint");
-        Info.GenClassName = BP->GeneratedClass ? BP->GeneratedClass->GetName() : FString();
-        All.Add(MoveTemp(Info));
-
-        NameToAssetKey.Add(BP->GetName(), ToAssetKeyFromClassPath(BP->GetOutermost()->GetName())); // package key
-        if (!Info.GenClassName.IsEmpty())
-            NameToAssetKey.Add(Info.GenClassName, ToAssetKeyFromClassPath(BP->GetOutermost()->GetName()));
+        for (const FAssetData& AD : Assets)
+        {
+            if (!Shard.Owns(AD)) AddNames(AD, ProjectRefAssetFromRegistry(AD));
+        }
+        Shard.Filter(Assets, TEXT("BP.ProjectRefs"));
     }
 
-    // 2) 레퍼런스 그래프 구축
-    TMap<FString, TSet<FString>> RefTo; // From -> {To,...}
-    for (const FAssetInfo& It : All)
+    FDumpManifest Manifest;
+    Manifest.Suffix = Shard.Suffix();
+    Manifest.Load(OutRoot);
+    BTD::FClassHierarchyCache::Get().Reset();
+    BTD::OutputStats().Reset();
+
+    // ensure packs (변경된 패키지만 로드/덤프, 나머지는 레지스트리 정보만 사용)
+    // RefsOnly: 변경된 패키지도 산출물은 쓰지 않고 메모리 스냅샷에서 레퍼런스만 뽑음
+    TArray<FString> ChangeKeys;
+    TBitArray<> UpToDate;
+    TArray<FName> ToLoad; // 로드할 패키지만, 방문 순서대로 prefetch
+    for (const FAssetData& AD : Assets)
     {
-        const FString From = It.PkgPath;
-        const FString PkgDir = FPaths::GetPath(From);
-        const FString BPDir = FPaths::Combine(OutRoot, PkgDir);
-        const FString BaseName = FPaths::GetCleanFilename(From); // Asset
+        ChangeKeys.Add(ChangeKeyForAsset(AD));
+        const bool bUpToDate = !bForce && Manifest.IsUpToDate(AD, ChangeKeys.Last(), OutRoot);
+        UpToDate.Add(bUpToDate);
+        if (!bUpToDate) ToLoad.Add(AD.PackageName);
+    }
+    BTD::FPackagePrefetcher Prefetch(MoveTemp(ToLoad), PrefetchWindow);
+    BTD::FMemoryBudget MemBudget(MemBudgetMB, TEXT("BP.ProjectRefs")); // FProjectRefAsset/FAssetRefSet은 문자열만 보관
+    MemBudget.SetKeepAlive([&Prefetch](TSet<FName>& Keep) { Prefetch.GetPackagesAhead(Keep); });
+    int32 LoadIndex = 0;
+    int32 LoadFailed = 0;
+    int32 FromMemory = 0, FromRefsFile = 0, FromArtifacts = 0;
+
+    TArray<FAssetRefSet> RefSets; // All과 같은 순서
+    TMap<int32, TArray<uint8>> MemFragments; // RefsOnly + Store: 파일로 쓰지 않은 조각
+    TMap<int32, BTD::FFactTable> MemFacts;   // RefsOnly + Facts: 파일로 쓰지 않은 fact
+    for (int32 i = 0; i < Assets.Num(); ++i)
+    {
+        const FAssetData& AD = Assets[i];
+        FProjectRefAsset Info;
+        FAssetRefSet Refs;
+        if (UpToDate[i])
+        {
+            ++Manifest.Skipped;
+            Info = ProjectRefAssetFromRegistry(AD);
+
+            // 최신 산출물: bprefs.json 하나만 읽음 (없으면 이전 버전 산출물을 훑음)
+            const FString BPDir = FPaths::Combine(OutRoot, FPaths::GetPath(Info.PkgPath));
+            const FString BaseName = FPaths::GetCleanFilename(Info.PkgPath);
+            if (LoadRefsForBP(BPDir, BaseName, Refs)) ++FromRefsFile;
+            else { CollectRefsFromArtifacts(BPDir, BaseName, Refs); ++FromArtifacts; }
+        }
+        else
+        {
+            Prefetch.WaitFor(LoadIndex++);
+            UBlueprint* BP = Cast<UBlueprint>(AD.GetAsset());
+            TUniquePtr<FBPDumpJob> Job = SnapshotBlueprint(BP, OutRoot);
+            if (!Job)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("BP.ProjectRefs: Failed to load %s"), *AD.GetObjectPathString());
+                ++LoadFailed;
+                MemBudget.Tick();
+                continue;
+            }
+            Info.PkgPath = Job->PackageName; // "/Game/.../Asset"
+            Info.AssetType = BP->IsA<UWidgetBlueprint>() ? TEXT("WidgetBlueprint") : TEXT("Blueprint");
+            Info.GenClassName = BP->GeneratedClass ? BP->GeneratedClass->GetName() : FString();
+            Prefetch.Pump(PrefetchPumpSeconds);
+            MemBudget.Tick(); // 이후로는 스냅샷만 사용
 
-        // 2.a) bpmeta.json
-        const FString MetaPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__BP__Meta.bpmeta.json"), *BaseName));
-        if (TSharedPtr<FJsonObject> JM = LoadJsonObject(MetaPath))
-        {
-            FString ParentPath;
-            if (JM->TryGetStringField(TEXT("bp_parent_class_path"), ParentPath))
-                AddRef(RefTo, From, ToAssetKeyFromClassPath(ParentPath));
-            const TArray<TSharedPtr<FJsonValue>>* Ifaces = nullptr;
-            if (JM->TryGetArrayField(TEXT("implemented_interfaces"), Ifaces))
+            if (bRefsOnly)
             {
-                for (const auto& V : *Ifaces)
+                if (bFactStore)
+                {
+                    CollectRefsFromJob(*Job, Refs, /*bWithFacts*/ false);
+                    CollectFactsForBP(Job->BPName, Job->Graphs, MemFacts.Add(All.Num()), &Refs);
+                }
+                else
                 {
-                    FString P; if (V->TryGetString(P))
-                        AddRef(RefTo, From, ToAssetKeyFromClassPath(P));
+                    CollectRefsFromJob(*Job, Refs, /*bWithFacts*/ true);
                 }
+                if (bStore)
+                {
+                    BTD::FScopedUtf8Builder Frag;
+                    BTD::BuildGraphFragment(Job->PackageName, Job->Graphs, *Frag);
+                    MemFragments.Add(All.Num(), Frag->Bytes);
+                }
+            }
+            else
+            {
+                EmitBlueprintJob(*Job, &Refs);
+                Manifest.Record(AD, ChangeKeys[i]);
             }
+            ++FromMemory;
         }
 
-        // 2.b) bpcatalog.json -> 그래프 목록
-        const FString CatalogPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpcatalog.json"), *BaseName));
-        TArray<FString> GraphNames;
-        if (TSharedPtr<FJsonObject> JC = LoadJsonObject(CatalogPath))
+        AddNames(AD, Info);
+        All.Add(MoveTemp(Info));
+        RefSets.Add(MoveTemp(Refs));
+    }
+    if (!bRefsOnly) Manifest.SaveIfWritten(OutRoot, TEXT("BP.ProjectRefs"));
+    UE_LOG(LogTemp, Display, TEXT("BP.ProjectRefs: %d assets, %d unchanged (not reloaded); refs from memory %d, bprefs %d, legacy artifacts %d"),
+        All.Num(), Manifest.Skipped, FromMemory, FromRefsFile, FromArtifacts);
+    Prefetch.Log(TEXT("BP.ProjectRefs"));
+    MemBudget.Log();
+
+    // 2) 레퍼런스 그래프 구축 (이름은 전체 인덱스가 완성된 뒤 해석)
+    const double GraphT0 = FPlatformTime::Seconds();
+    for (int32 i = 0; i < All.Num(); ++i)
+    {
+        const int32 From = Graph.Intern(All[i].PkgPath);
+        for (const FString& Key : RefSets[i].Keys)
+            Graph.AddEdge(From, Graph.Intern(Key));
+        for (const FString& Name : RefSets[i].Names)
         {
-            const TArray<TSharedPtr<FJsonValue>>* GArr = nullptr;
-            if (JC->TryGetArrayField(TEXT("graphs"), GArr))
-            {
-                for (const auto& V : *GArr) { FString N; if (V->TryGetString(N)) GraphNames.Add(N); }
-            }
+            if (const int32* To = NameToId.Find(Name))
+                Graph.AddEdge(From, *To);
+        }
+    }
+    RefSets.Empty();
+
+    // 3) 정방향/역방향 CSR (행은 키 순서)
+    Graph.Build();
+    UE_LOG(LogTemp, Display, TEXT("BP.ProjectRefs: graph %d keys, %d edges (%.3fs)"),
+        Graph.Num(), Graph.NumEdges(), FPlatformTime::Seconds() - GraphT0);
+
+    // 4) 결과 JSON. 샤드는 references_to만 (referenced_by는 BP.MergeShards에서 전체 기준으로 계산)
+    if (Shard.IsSharded())
+        WriteProjectReferences(ShardReferencesPath(OutRoot, Shard.Index, Shard.Count), All, Graph, /*bReferencedBy*/ false, &Shard);
+    else
+        WriteProjectReferences(FPaths::Combine(OutRoot, TEXT("project_references.json")), All, Graph, /*bReferencedBy*/ true);
+
+    // 5) 선택: BP.Query용 컬럼 저장소, BP.Facts용 fact DB
+    if (bStore) WriteProjectGraphStore(OutRoot, All, MemFragments);
+    if (bFactStore) WriteProjectFactStore(OutRoot, All, MemFacts);
+    BTD::FlushArtifacts();
+    BTD::OutputStats().Log(TEXT("BP.ProjectRefs"));
+    return (LoadFailed == 0 && BTD::OutputStats().Failed.load() == 0) ? EBPTextDumpResult::Ok : EBPTextDumpResult::Failed;
+}
+
+void FBPTextDumpModule::CmdMergeShards(const TArray<FString>& Args)
+{
+    RunMergeShards(Args);
+}
+
+// 샤드별 project_references.shard-i-of-N.json을 합쳐 project_references.json 생성.
+// 자산별 산출물은 다시 읽지 않음 (각 샤드 파일에 references_to가 이미 있음)
+EBPTextDumpResult FBPTextDumpModule::RunMergeShards(const TArray<FString>& Args)
+{
+    FString OutRoot = DefaultOutDir();
+    int32 Count = 0; // 0 = Out에서 찾은 샤드 파일로 결정
+    for (const FString& A : Args)
+    {
+        if (A.StartsWith(TEXT("Out="))) OutRoot = A.RightChop(4);
+        else if (A.StartsWith(TEXT("Shards="))) Count = FMath::Max(0, FCString::Atoi(*A.RightChop(7)));
+    }
+
+    if (Count == 0)
+    {
+        TArray<FString> Found;
+        IFileManager::Get().FindFiles(Found, *FPaths::Combine(OutRoot, TEXT("project_references.shard-*-of-*.json")), true, false);
+        for (const FString& F : Found)
+        {
+            FString Rest;
+            if (F.Split(TEXT("-of-"), nullptr, &Rest))
+                Count = FMath::Max(Count, FCString::Atoi(*FPaths::GetBaseFilename(Rest)));
         }
+    }
+    if (Count <= 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("BP.MergeShards: no shard files under %s"), *OutRoot);
+        return EBPTextDumpResult::Failed;
+    }
 
-        // 2.c) 각 graph의 bpflow.json: 핀 기본 오브젝트 경로 스캔
-        for (const FString& GName : GraphNames)
+    TArray<FProjectRefAsset> All;
+    BTD::FRefGraph Graph;
+    int32 Missing = 0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FString Path = ShardReferencesPath(OutRoot, i, Count);
+        TSharedPtr<FJsonObject> J = LoadJsonObject(Path);
+        const TSharedPtr<FJsonObject>* JAssets = nullptr;
+        if (!J.IsValid() || !J->TryGetObjectField(TEXT("assets"), JAssets))
+        {
+            UE_LOG(LogTemp, Error, TEXT("BP.MergeShards: missing or invalid %s"), *Path);
+            ++Missing;
+            continue;
+        }
+        for (const auto& KV : (*JAssets)->Values)
         {
-            const FString FlowPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s__%s.bpflow.json"), *BaseName, *GName));
-            if (TSharedPtr<FJsonObject> JF = LoadJsonObject(FlowPath))
+            const TSharedPtr<FJsonObject>* JOne = nullptr;
+            if (!KV.Value->TryGetObject(JOne)) continue;
+            FProjectRefAsset Info;
+            Info.PkgPath = KV.Key;
+            (*JOne)->TryGetStringField(TEXT("asset_type"), Info.AssetType);
+            const int32 From = Graph.Intern(Info.PkgPath);
+            const TArray<TSharedPtr<FJsonValue>>* Tos = nullptr;
+            if ((*JOne)->TryGetArrayField(TEXT("references_to"), Tos))
             {
-                const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
-                if (JF->TryGetArrayField(TEXT("nodes"), Nodes))
+                for (const auto& V : *Tos)
                 {
-                    for (const auto& NV : *Nodes)
-                    {
-                        const TSharedPtr<FJsonObject>* NObj = nullptr; if (!NV->TryGetObject(NObj)) continue;
-                        const TArray<TSharedPtr<FJsonValue>>* Pins = nullptr;
-                        if ((*NObj)->TryGetArrayField(TEXT("pins"), Pins))
-                        {
-                            for (const auto& PV : *Pins)
-                            {
-                                const TSharedPtr<FJsonObject>* PObj = nullptr; if (!PV->TryGetObject(PObj)) continue;
-                                FString DOP;
-                                if ((*PObj)->TryGetStringField(TEXT("default_object_path"), DOP))
-                                    AddRef(RefTo, From, ToAssetKeyFromObjectPath(DOP));
-                                FString DO2;
-                                if ((*PObj)->TryGetStringField(TEXT("default_object"), DO2))
-                                    AddRef(RefTo, From, ToAssetKeyFromObjectPath(DO2));
-                            }
-                        }
-                    }
+                    FString To; if (V->TryGetString(To) && !To.IsEmpty()) Graph.AddEdge(From, Graph.Intern(To));
                 }
             }
+            All.Add(MoveTemp(Info));
         }
+    }
+    if (Missing > 0) return EBPTextDumpResult::Failed;
 
-        // 2.d) bpfacts.ndjson: depends_on 등에서 클래스명/경로 해석
-        const FString FactsPath = FPaths::Combine(BPDir, FString::Printf(TEXT("%s.bpfacts.ndjson"), *BaseName));
-        ReadNDJSONLines(FactsPath, [&](const TSharedPtr<FJsonObject>& O)
-            {
-                FString S, P, Obj;
-                O->TryGetStringField(TEXT("s"), S);
-                O->TryGetStringField(TEXT("p"), P);
-                O->TryGetStringField(TEXT("o"), Obj);
-                if (Obj.IsEmpty()) return;
-                // 1) 경로 그대로
-                if (Obj.StartsWith(TEXT("/Game/")) || Obj.StartsWith(TEXT("/Script/")))
-                {
-                    AddRef(RefTo, From, ToAssetKeyFromClassPath(Obj));
-                    return;
-                }
-                // 2) "Class.Func" 형태면 Class 추출 → 이름 인덱스로 매핑
-                int32 Dot = INDEX_NONE;
-                if (Obj.FindChar(TCHAR('.'), Dot))
-                {
-                    const FString OwnerName = Obj.Left(Dot);
-                    if (const FString* Key = NameToAssetKey.Find(OwnerName))
-                    {
-                        AddRef(RefTo, From, *Key);
-                    }
-                }
-                else
-                {
-                    // 3) 순수 이름(위젯/BP 변수명 등)도 일치하면 매핑
-                    if (const FString* Key = NameToAssetKey.Find(Obj))
-                        AddRef(RefTo, From, *Key);
-                }
-            });
+    // 샤드 순서와 무관하게 같은 출력
+    All.Sort([](const FProjectRefAsset& A, const FProjectRefAsset& B) { return A.PkgPath < B.PkgPath; });
+
+    Graph.Build();
+    BTD::OutputStats().Reset();
+    WriteProjectReferences(FPaths::Combine(OutRoot, TEXT("project_references.json")), All, Graph, /*bReferencedBy*/ true);
+    BTD::FlushArtifacts();
+    UE_LOG(LogTemp, Display, TEXT("BP.MergeShards: merged %d shards, %d assets into %s"), Count, All.Num(), *OutRoot);
+    BTD::OutputStats().Log(TEXT("BP.MergeShards"));
+    return BTD::OutputStats().Failed.load() == 0 ? EBPTextDumpResult::Ok : EBPTextDumpResult::Failed;
+}
+
+void FBPTextDumpModule::CmdQuery(const TArray<FString>& Args)
+{
+    RunQuery(Args);
+}
+
+// project_graph.btdstore (BP.ProjectRefs Store)를 매핑해서 노드 검색
+// Calls=Func: 함수 호출 노드, Reads=Var / Writes=Var: 변수 Get / Set, Var=Var: 변수 노드 전부
+bool FBPTextDumpModule::RunQuery(const TArray<FString>& Args)
+{
+    FString OutRoot = DefaultOutDir();
+    FString Calls, Reads, Writes, Var;
+    int32 Limit = 200;
+    for (const FString& A : Args)
+    {
+        if (A.StartsWith(TEXT("Out="))) OutRoot = A.RightChop(4);
+        else if (A.StartsWith(TEXT("Calls="))) Calls = A.RightChop(6);
+        else if (A.StartsWith(TEXT("Reads="))) Reads = A.RightChop(6);
+        else if (A.StartsWith(TEXT("Writes="))) Writes = A.RightChop(7);
+        else if (A.StartsWith(TEXT("Var="))) Var = A.RightChop(4);
+        else if (A.StartsWith(TEXT("Limit="))) Limit = FMath::Max(0, FCString::Atoi(*A.RightChop(6)));
     }
 
-    // 3) 역방향 맵 구성
-    TMap<FString, TSet<FString>> RefBy;
-    for (const auto& kv : RefTo)
-        for (const FString& To : kv.Value)
-            RefBy.FindOrAdd(To).Add(kv.Key);
+    using BTD::EGraphStoreSection;
+    const bool bCalls = !Calls.IsEmpty();
+    const FString& Name = bCalls ? Calls : !Reads.IsEmpty() ? Reads : !Writes.IsEmpty() ? Writes : Var;
+    if (Name.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("BP.Query: one of Calls=, Reads=, Writes=, Var= is required"));
+        return false;
+    }
+    const int32 KindFilter = !Reads.IsEmpty() ? int32(BTD::ENodeKind::VariableGet)
+        : !Writes.IsEmpty() ? int32(BTD::ENodeKind::VariableSet) : INDEX_NONE;
 
-    // 4) 결과 JSON 구성
-    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
-    Root->SetStringField(TEXT("project_name"), FApp::GetProjectName());
-    Root->SetStringField(TEXT("analysis_timestamp"), FDateTime::Now().ToIso8601());
-    TSharedRef<FJsonObject> JAssets = MakeShared<FJsonObject>();
-    for (const FAssetInfo& It : All)
+    BTD::FlushArtifacts(); // 방금 BP.ProjectRefs Store가 큐에 넣은 파일일 수 있음
+    const FString Path = ProjectGraphStorePath(OutRoot);
+    BTD::FGraphStoreReader Store;
+    if (!Store.Open(Path))
     {
-        TSharedRef<FJsonObject> JOne = MakeShared<FJsonObject>();
-        JOne->SetStringField(TEXT("asset_type"), It.AssetType);
-        // references_to
-        {
-            TArray<TSharedPtr<FJsonValue>> Arr;
-            const TSet<FString>* S = RefTo.Find(It.PkgPath);
-            if (S) { TArray<FString> V = S->Array(); V.RemoveAll([](const FString& X) { return X.IsEmpty(); }); V.Sort(); for (const FString& T : V) Arr.Add(MakeShared<FJsonValueString>(T)); }
-            JOne->SetArrayField(TEXT("references_to"), Arr);
-        }
-        // referenced_by
-        {
-            TArray<TSharedPtr<FJsonValue>> Arr;
-            const TSet<FString>* S = RefBy.Find(It.PkgPath);
-            if (S) { TArray<FString> V = S->Array(); V.RemoveAll([](const FString& X) { return X.IsEmpty(); }); V.Sort(); for (const FString& T : V) Arr.Add(MakeShared<FJsonValueString>(T)); }
-            JOne->SetArrayField(TEXT("referenced_by"), Arr);
-        }
-        JAssets->SetObjectField(*It.PkgPath, JOne);
+        UE_LOG(LogTemp, Error, TEXT("BP.Query: cannot open %s (run BP.ProjectRefs Store first)"), *Path);
+        return false;
     }
-    Root->SetObjectField(TEXT("assets"), JAssets);
 
-    const FString OutPath = FPaths::Combine(OutRoot, TEXT("project_references.json"));
-    WriteJsonToFile(*Root, OutPath);
+    const double T0 = FPlatformTime::Seconds();
+    const BTD::FStringIdRun StrIds = Store.FindStrings(Name); // 대소문자만 다른 이름도 모두
+    const TConstArrayView<uint32> Nodes = bCalls ? Store.NodesByFunc(StrIds) : Store.NodesByVar(StrIds);
+
+    int32 Matches = 0;
+    TSet<uint32> Blueprints;
+    const uint32* NodeBP = Store.Col<uint32>(EGraphStoreSection::NodeBlueprint);
+    for (const uint32 N : Nodes)
+    {
+        if (KindFilter != INDEX_NONE && int32(Store.NodeKindOf(N)) != KindFilter) continue;
+        ++Matches;
+        Blueprints.Add(NodeBP[N]);
+        if (Matches > Limit) continue; // 개수는 끝까지 셈
+        UE_LOG(LogTemp, Display, TEXT("  %s | %s | %s | %s"),
+            *Store.NodeBlueprintPath(N),
+            *Store.Str(Store.NodeU32(EGraphStoreSection::NodeGraph, N)),
+            *Store.Str(Store.NodeU32(EGraphStoreSection::NodeAnchor, N)),
+            *Store.Str(Store.NodeU32(EGraphStoreSection::NodeTitle, N)));
+    }
+    if (Matches > Limit)
+        UE_LOG(LogTemp, Display, TEXT("  ... %d more (Limit=%d)"), Matches - Limit, Limit);
+    UE_LOG(LogTemp, Display, TEXT("BP.Query: %s: %d nodes in %d blueprints (%.2f ms, %u blueprints / %u nodes in store)"),
+        *Name, Matches, Blueprints.Num(), (FPlatformTime::Seconds() - T0) * 1000.0,
+        Store.Header().NumBlueprints, Store.Header().NumNodes);
+    return true;
+}
+
+void FBPTextDumpModule::CmdFacts(const TArray<FString>& Args)
+{
+    RunFacts(Args);
 }
 
+// project_facts.btdfacts (BP.ProjectRefs Facts)를 매핑해서 S= / P= / O= 조합으로 검색
+// 예: BP.Facts P=controls_visibility_of O=LoadingPanel
+bool FBPTextDumpModule::RunFacts(const TArray<FString>& Args)
+{
+    FString OutRoot = DefaultOutDir();
+    FString Terms[3]; // s, p, o
+    bool bBound[3] = { false, false, false };
+    int32 Limit = 200;
+    for (const FString& A : Args)
+    {
+        if (A.StartsWith(TEXT("Out="))) OutRoot = A.RightChop(4);
+        else if (A.StartsWith(TEXT("S="))) { Terms[0] = A.RightChop(2); bBound[0] = true; }
+        else if (A.StartsWith(TEXT("P="))) { Terms[1] = A.RightChop(2); bBound[1] = true; }
+        else if (A.StartsWith(TEXT("O="))) { Terms[2] = A.RightChop(2); bBound[2] = true; }
+        else if (A.StartsWith(TEXT("Limit="))) Limit = FMath::Max(0, FCString::Atoi(*A.RightChop(6)));
+    }
+    if (!bBound[0] && !bBound[1] && !bBound[2])
+    {
+        UE_LOG(LogTemp, Error, TEXT("BP.Facts: at least one of S=, P=, O= is required"));
+        return false;
+    }
+
+    BTD::FlushArtifacts(); // 방금 BP.ProjectRefs Facts가 큐에 넣은 파일일 수 있음
+    const FString Path = ProjectFactStorePath(OutRoot);
+    BTD::FFactStoreReader Store;
+    if (!Store.Open(Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("BP.Facts: cannot open %s (run BP.ProjectRefs Facts first)"), *Path);
+        return false;
+    }
+
+    const double T0 = FPlatformTime::Seconds();
+    BTD::FStringIdRun Ids[3]; // 대소문자만 다른 문자열은 각각 다른 id
+    bool bUnknown = false;
+    for (int32 i = 0; i < 3; ++i)
+    {
+        if (!bBound[i]) continue;
+        Ids[i] = Store.FindStrings(Terms[i]);
+        if (Ids[i].IsEmpty()) bUnknown = true; // 저장소에 없는 문자열 → 결과 없음
+    }
+    TArray<uint32> Rows;
+    if (!bUnknown)
+        Store.Match(bBound[0] ? &Ids[0] : nullptr, bBound[1] ? &Ids[1] : nullptr, bBound[2] ? &Ids[2] : nullptr, Rows);
+    const double Ms = (FPlatformTime::Seconds() - T0) * 1000.0;
+
+    using BTD::EFactStoreSection;
+    for (int32 i = 0; i < FMath::Min(Rows.Num(), Limit); ++i)
+    {
+        const uint32 R = Rows[i];
+        UE_LOG(LogTemp, Display, TEXT("  %s | %s %s %s | %s"),
+            *Store.Str(Store.Fact(EFactStoreSection::FactBlueprint, R)),
+            *Store.Str(Store.Fact(EFactStoreSection::FactS, R)),
+            *Store.Str(Store.Fact(EFactStoreSection::FactP, R)),
+            *Store.Str(Store.Fact(EFactStoreSection::FactO, R)),
+            *Store.Str(Store.Fact(EFactStoreSection::FactAnchor, R)));
+    }
+    if (Rows.Num() > Limit)
+        UE_LOG(LogTemp, Display, TEXT("  ... %d more (Limit=%d)"), Rows.Num() - Limit, Limit);
+    UE_LOG(LogTemp, Display, TEXT("BP.Facts: %d facts (lookup %.3f ms, %u facts / %u blueprints in store)"),
+        Rows.Num(), Ms, Store.Header().NumFacts, Store.Header().NumBlueprints);
+    return true;
+}
 
 void FBPTextDumpModule::UnregisterMenus()
 {
@@ -22,23 +22,125 @@ namespace BTD
         return Hex(Digest, 20);
     }
 
-    inline FString NodeSignature(const UEdGraphNode* N)
+    // TCHAR text  UTF-8  FSHA1, through a stack buffer (same bytes as FTCHARToUTF8).
+    class FUtf8SHA1Stream
     {
-        if (!N) return TEXT("");
-        FString S;
-        S += N->GetClass()->GetName(); S += TEXT("|");
-        S += N->GetNodeTitle(ENodeTitleType::ListView).ToString(); S += TEXT("|");
+    public:
+        void Append(const TCHAR* S, int32 Len)
+        {
+            for (int32 i = 0; i < Len; ++i)
+            {
+                uint32 C = (uint32)S[i];
+                if (sizeof(TCHAR) == 2 && C >= 0xD800 && C <= 0xDFFF)
+                {
+                    // UTF-16 surrogate pair  one codepoint, lone surrogate  '?'
+                    const uint32 Lo = (i + 1 < Len) ? (uint32)S[i + 1] : 0u;
+                    if (C <= 0xDBFF && Lo >= 0xDC00 && Lo <= 0xDFFF) { C = 0x10000 + ((C - 0xD800) << 10) + (Lo - 0xDC00); ++i; }
+                    else C = '?';
+                }
+                else if (C > 0x10FFFF) C = '?';
+                Put(C);
+            }
+        }
+        void Append(const FString& S) { Append(*S, S.Len()); }
+        void Append(const TCHAR* S)   { Append(S, FCString::Strlen(S)); }
+        void Append(FName N)
+        {
+            TCHAR Buf[NAME_SIZE];
+            const uint32 Len = N.ToString(Buf, NAME_SIZE);   // "None" for NAME_None, like ToString()
+            Append(Buf, (int32)Len);
+        }
 
-        // Pins (stable order by name): copy, drop nulls, then sort
-        TArray<UEdGraphPin*> Pins = N->Pins;
-        Pins.RemoveAll([](UEdGraphPin* P) { return P == nullptr; });
+        // "A" + first 10 hex of the digest
+        FString FinishAnchor()
+        {
+            Flush();
+            Sha.Final();
+            uint8 Digest[20];
+            Sha.GetHash(Digest);
+
+            static const TCHAR* D = TEXT("0123456789abcdef");
+            TCHAR Out[12];
+            Out[0] = TEXT('A');
+            for (int32 i = 0; i < 5; ++i) { Out[1 + i * 2] = D[Digest[i] >> 4]; Out[2 + i * 2] = D[Digest[i] & 0xF]; }
+            Out[11] = 0;
+            return FString(11, Out);
+        }
 
-        // NOTE: for pointer arrays, Sort's comparator gets **const UEdGraphPin&** (dereferenced)
-        Pins.Sort([](const UEdGraphPin& A, const UEdGraphPin& B)
+    private:
+        void Put(uint32 C)
+        {
+            if (Used + 4 > BufSize) Flush();
+            if (C < 0x80) { Buf[Used++] = (uint8)C; }
+            else if (C < 0x800) { Buf[Used++] = (uint8)(0xC0 | (C >> 6)); Buf[Used++] = (uint8)(0x80 | (C & 0x3F)); }
+            else if (C < 0x10000)
             {
-                const FString AN = A.PinName.ToString();
-                const FString BN = B.PinName.ToString();
-                if (AN != BN) return AN < BN;
+                Buf[Used++] = (uint8)(0xE0 | (C >> 12)); Buf[Used++] = (uint8)(0x80 | ((C >> 6) & 0x3F)); Buf[Used++] = (uint8)(0x80 | (C & 0x3F));
+            }
+            else
+            {
+                Buf[Used++] = (uint8)(0xF0 | (C >> 18)); Buf[Used++] = (uint8)(0x80 | ((C >> 12) & 0x3F));
+                Buf[Used++] = (uint8)(0x80 | ((C >> 6) & 0x3F)); Buf[Used++] = (uint8)(0x80 | (C & 0x3F));
+            }
+        }
+        void Flush()
+        {
+            if (Used > 0) { Sha.Update(Buf, Used); Used = 0; }
+        }
+
+        static constexpr int32 BufSize = 512;
+        FSHA1 Sha;
+        uint8 Buf[BufSize];
+        int32 Used = 0;
+    };
+
+    // Stable anchor: sha1(GUID|sig)  "A" + first 10 hex
+    // sig = class|ListView title|pins sorted by name (case-insensitive), then direction, exec, address:
+    //       name:category:subcategory:in/out:x/d;
+    // Streamed straight into the hash; pins are sorted on an inline array.
+    inline FString AnchorForNode(const UEdGraphNode* N)
+    {
+        FUtf8SHA1Stream H;
+        if (!N) return H.FinishAnchor();
+
+        if (N->NodeGuid.IsValid())
+        {
+            TCHAR GuidBuf[40];
+            const int32 GuidLen = FCString::Sprintf(GuidBuf, TEXT("{%08X-%04X-%04X-%04X-%04X%08X}"),
+                N->NodeGuid.A, N->NodeGuid.B >> 16, N->NodeGuid.B & 0xFFFF,
+                N->NodeGuid.C >> 16, N->NodeGuid.C & 0xFFFF, N->NodeGuid.D);
+            H.Append(GuidBuf, GuidLen);
+            H.Append(TEXT("|"), 1);
+        }
+        H.Append(N->GetClass()->GetFName()); H.Append(TEXT("|"), 1);
+        H.Append(N->GetNodeTitle(ENodeTitleType::ListView).ToString()); H.Append(TEXT("|"), 1);
+
+        // Pin names are flattened once into an inline arena; sorting compares FNames for
+        // equality and falls back to Stricmp on the flattened text for order (FName::Compare
+        // orders numbered names differently from the FString comparison anchors were built with).
+        struct FPinKey { const UEdGraphPin* Pin; int32 NameOffset; };
+        TArray<FPinKey, TInlineAllocator<32>> Pins;
+        TArray<TCHAR, TInlineAllocator<1024>> Names;
+        for (const UEdGraphPin* P : N->Pins)
+        {
+            if (!P) continue;
+            TCHAR Buf[NAME_SIZE];
+            const uint32 Len = P->PinName.ToString(Buf, NAME_SIZE);
+            Pins.Add({ P, Names.Num() });
+            Names.Append(Buf, (int32)Len);
+            Names.Add(0);
+        }
+
+        const TCHAR* NameData = Names.GetData();
+        Pins.Sort([NameData](const FPinKey& KA, const FPinKey& KB)
+            {
+                const UEdGraphPin& A = *KA.Pin;
+                const UEdGraphPin& B = *KB.Pin;
+                if (A.PinName != B.PinName)
+                {
+                    const int32 Cmp = FCString::Stricmp(NameData + KA.NameOffset, NameData + KB.NameOffset);
+                    if (Cmp != 0) return Cmp < 0;
+                }
 
                 if (A.Direction != B.Direction) return A.Direction < B.Direction;
 
@@ -50,32 +152,15 @@ namespace BTD
                 return &A < &B;
             });
 
-        for (UEdGraphPin* P : Pins)
-        {
-            // P null ƴ ( )
-            S += P->PinName.ToString(); S += TEXT(":");
-            S += P->PinType.PinCategory.ToString(); S += TEXT(":");
-            S += P->PinType.PinSubCategory.ToString(); S += TEXT(":");
-            S += (P->Direction == EGPD_Input) ? TEXT("in") : TEXT("out"); S += TEXT(":");
-            S += (P->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) ? TEXT("x") : TEXT("d"); S += TEXT(";");
-        }
-        return S;
-    }
-
-
-
-    // Stable anchor: sha1(GUID|sig)  "A" + first 10 hex
-    inline FString AnchorForNode(const UEdGraphNode* N)
-    {
-        FString Sig;
-        if (N && N->NodeGuid.IsValid())
+        for (const FPinKey& K : Pins)
         {
-            Sig += N->NodeGuid.ToString(EGuidFormats::DigitsWithHyphensInBraces);
-            Sig += TEXT("|");
+            const UEdGraphPin* P = K.Pin;
+            H.Append(NameData + K.NameOffset); H.Append(TEXT(":"), 1);
+            H.Append(P->PinType.PinCategory); H.Append(TEXT(":"), 1);
+            H.Append(P->PinType.PinSubCategory); H.Append(TEXT(":"), 1);
+            H.Append((P->Direction == EGPD_Input) ? TEXT("in") : TEXT("out")); H.Append(TEXT(":"), 1);
+            H.Append((P->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) ? TEXT("x") : TEXT("d"), 1); H.Append(TEXT(";"), 1);
         }
-        Sig += NodeSignature(N);
-        FTCHARToUTF8 Bytes(*Sig);
-        const FString H = SHA1(Bytes.Get(), Bytes.Length());
-        return FString::Printf(TEXT("A%.*s"), 10, *H);
+        return H.FinishAnchor();
     }
 }
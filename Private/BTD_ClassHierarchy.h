@@ -0,0 +1,124 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+// Class hierarchy cache for defined_in resolution (game thread only, reset per dump command).
+// Every class seen as a Blueprint parent (or interface) gets one entry with its super chain
+// flattened to entry indices and the names of the properties / functions it declares itself.
+// Whether a class or any of its supers has a member is memoized per (class, member), so
+// Blueprints sharing a parent chain such as Character or UserWidget resolve with hash lookups only.
+namespace BTD
+{
+    enum class EClassMember : uint8
+    {
+        Property,
+        Function,
+    };
+
+    class FClassHierarchyCache
+    {
+    public:
+        static FClassHierarchyCache& Get()
+        {
+            static FClassHierarchyCache Instance;
+            return Instance;
+        }
+
+        // Class 또는 그 슈퍼 중 하나라도 Member를 가지면 Class 자신의 경로, 없으면 ""
+        // (슈퍼까지 찾는 FindFProperty / FindFunctionByName으로 부모 체인을 훑던 결과와 같음)
+        FString FindMemberClassPath(UClass* Class, FName Member, EClassMember Kind)
+        {
+            if (!Class || Member.IsNone()) return FString();
+
+            const int32 Entry = FindOrAddEntry(Class);
+            const FMemberKey Key(Entry, Member, Kind);
+            if (const bool* Found = Resolved.Find(Key))
+            {
+                ++Hits;
+                return *Found ? Entries[Entry].Path : FString();
+            }
+            ++Misses;
+
+            bool bHas = false;
+            for (const int32 C : Entries[Entry].Chain)
+            {
+                const FClassEntry& E = Entries[C];
+                if ((Kind == EClassMember::Property ? E.Properties : E.Functions).Contains(Member))
+                {
+                    bHas = true;
+                    break;
+                }
+            }
+            Resolved.Add(Key, bHas);
+            return bHas ? Entries[Entry].Path : FString();
+        }
+
+        void Reset()
+        {
+            Entries.Reset();
+            EntryByClass.Reset();
+            Resolved.Reset();
+            Hits = 0;
+            Misses = 0;
+        }
+
+        void LogStats(const TCHAR* Label) const
+        {
+            UE_LOG(LogTemp, Display, TEXT("%s: class hierarchy cache %d classes, %lld resolved, %lld reused"),
+                Label, Entries.Num(), Misses, Hits);
+        }
+
+    private:
+        using FMemberKey = TTuple<int32, FName, EClassMember>;
+
+        struct FClassEntry
+        {
+            FString Path;
+            TArray<int32> Chain;        // 루트부터 자신까지의 엔트리 인덱스
+            TSet<FName> Properties;     // 이 클래스가 직접 선언한 것만
+            TSet<FName> Functions;      // 직접 선언 + 구현한 인터페이스의 함수
+        };
+
+        int32 FindOrAddEntry(UClass* Class)
+        {
+            const FObjectKey ClassKey(Class);
+            if (const int32* Found = EntryByClass.Find(ClassKey)) return *Found;
+
+            // 슈퍼부터 (재귀 깊이 = 상속 깊이)
+            TArray<int32> Chain;
+            if (UClass* Super = Class->GetSuperClass())
+            {
+                Chain = Entries[FindOrAddEntry(Super)].Chain;
+            }
+
+            const int32 Id = Entries.AddDefaulted();
+            FClassEntry& E = Entries[Id];
+            E.Path = Class->GetPathName();
+            E.Chain = MoveTemp(Chain);
+            E.Chain.Add(Id);
+            for (TFieldIterator<FProperty> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+            {
+                E.Properties.Add(It->GetFName());
+            }
+            for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+            {
+                E.Functions.Add(It->GetFName());
+            }
+            for (const FImplementedInterface& I : Class->Interfaces)
+            {
+                if (!I.Class) continue;
+                for (TFieldIterator<UFunction> It(I.Class); It; ++It) E.Functions.Add(It->GetFName());
+            }
+            EntryByClass.Add(ClassKey, Id);
+            return Id;
+        }
+
+        TArray<FClassEntry> Entries;
+        TMap<FObjectKey, int32> EntryByClass;   // FObjectKey: GC 후 같은 주소의 다른 클래스와 섞이지 않음
+        TMap<FMemberKey, bool> Resolved;        // → 클래스 또는 슈퍼 체인에 멤버가 있는지
+        int64 Hits = 0;
+        int64 Misses = 0;
+    };
+}
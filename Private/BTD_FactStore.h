@@ -0,0 +1,268 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "BTD_StringTable.h"
+
+// Project fact database (project_facts.btdfacts) for BP.Facts.
+//
+// BP.ProjectRefs Facts merges every Blueprint's facts into one file: a sorted string table,
+// one row per (blueprint, s, p, o) with its first evidence anchor, and three permutation
+// indexes over the rows (SPO, POS, OSP). Any query that binds s, p and/or o is a prefix of one
+// of them, so it is two binary searches over the mapped file regardless of project size.
+namespace BTD
+{
+    enum class EFactStoreSection : uint32
+    {
+        StrOffsets,         // uint32[NumStrings + 1], byte offsets into StrBlob
+        StrBlob,            // UTF-8, strings sorted case-insensitively, then case-sensitively (id 0 = "")
+        FactBlueprint,      // uint32[NumFacts] ...
+        FactS,
+        FactP,
+        FactO,
+        FactAnchor,         // first evidence anchor
+        SPO,                // row ids sorted by (s, p, o, row)
+        POS,                // (p, o, s, row)
+        OSP,                // (o, s, p, row)
+        Count
+    };
+
+    struct FFactStoreHeader
+    {
+        uint8  Magic[8];
+        uint32 Version;
+        uint32 NumStrings;
+        uint32 NumFacts;
+        uint32 NumBlueprints;
+        uint64 Offsets[(uint32)EFactStoreSection::Count];
+        uint64 Sizes[(uint32)EFactStoreSection::Count];
+    };
+
+    static constexpr uint8 FactStoreMagic[8] = { 'B', 'T', 'D', 'F', 'A', 'C', 'T', 'S' };
+    static constexpr uint32 FactStoreVersion = 1;
+
+    class FFactStoreWriter
+    {
+    public:
+        // 이후 Add()는 이 BP의 fact
+        void BeginBlueprint(const FString& BlueprintPath)
+        {
+            CurrentBP = Strings.Intern(BlueprintPath);
+            ++NumBP;
+        }
+
+        void Add(const FString& S, const FString& P, const FString& O, const FString& Anchor)
+        {
+            FactBlueprint.Add(CurrentBP);
+            FactS.Add(Strings.Intern(S));
+            FactP.Add(Strings.Intern(P));
+            FactO.Add(Strings.Intern(O));
+            FactAnchor.Add(Strings.Intern(Anchor));
+        }
+
+        int32 NumFacts() const      { return FactS.Num(); }
+        int32 NumBlueprints() const { return NumBP; }
+
+        void Finish(TArray<uint8>& Out)
+        {
+            // 문자열 id를 정렬 순위로. 대소문자만 다른 문자열은 연속된 id가 되므로 FindStrings가 구간으로 찾음
+            const int32 NS = Strings.Num();
+            TArray<uint32> Rank, StrOffsets;
+            TArray<uint8> StrBlob;
+            Strings.Finish(Rank, StrOffsets, StrBlob);
+            for (TArray<uint32>* Col : { &FactBlueprint, &FactS, &FactP, &FactO, &FactAnchor })
+            {
+                for (uint32& Id : *Col) Id = Rank[Id];
+            }
+
+            const TArray<uint32> SPO = MakeIndex(FactS, FactP, FactO);
+            const TArray<uint32> POS = MakeIndex(FactP, FactO, FactS);
+            const TArray<uint32> OSP = MakeIndex(FactO, FactS, FactP);
+
+            FFactStoreHeader H;
+            FMemory::Memzero(H);
+            FMemory::Memcpy(H.Magic, FactStoreMagic, sizeof(H.Magic));
+            H.Version = FactStoreVersion;
+            H.NumStrings = NS;
+            H.NumFacts = FactS.Num();
+            H.NumBlueprints = NumBP;
+
+            Out.Reset();
+            Out.AddZeroed(sizeof(FFactStoreHeader));
+            auto PutCol = [&](EFactStoreSection S, const auto& Col)
+                {
+                    Out.AddZeroed(Align(Out.Num(), 8) - Out.Num());
+                    H.Offsets[(uint32)S] = Out.Num();
+                    H.Sizes[(uint32)S] = Col.Num() * Col.GetTypeSize();
+                    Out.Append((const uint8*)Col.GetData(), Col.Num() * Col.GetTypeSize());
+                };
+            PutCol(EFactStoreSection::StrOffsets, StrOffsets);
+            PutCol(EFactStoreSection::StrBlob, StrBlob);
+            PutCol(EFactStoreSection::FactBlueprint, FactBlueprint);
+            PutCol(EFactStoreSection::FactS, FactS);
+            PutCol(EFactStoreSection::FactP, FactP);
+            PutCol(EFactStoreSection::FactO, FactO);
+            PutCol(EFactStoreSection::FactAnchor, FactAnchor);
+            PutCol(EFactStoreSection::SPO, SPO);
+            PutCol(EFactStoreSection::POS, POS);
+            PutCol(EFactStoreSection::OSP, OSP);
+
+            FMemory::Memcpy(Out.GetData(), &H, sizeof(H));
+        }
+
+    private:
+        static TArray<uint32> MakeIndex(const TArray<uint32>& A, const TArray<uint32>& B, const TArray<uint32>& C)
+        {
+            TArray<uint32> Index;
+            Index.SetNumUninitialized(A.Num());
+            for (int32 i = 0; i < A.Num(); ++i) Index[i] = i;
+            Index.Sort([&](uint32 X, uint32 Y)
+                {
+                    if (A[X] != A[Y]) return A[X] < A[Y];
+                    if (B[X] != B[Y]) return B[X] < B[Y];
+                    if (C[X] != C[Y]) return C[X] < C[Y];
+                    return X < Y;
+                });
+            return Index;
+        }
+
+        FSortedStringTableWriter Strings;  // BP별 fact 테이블처럼 대소문자 구분
+        uint32 CurrentBP = 0;
+        int32 NumBP = 0;
+
+        TArray<uint32> FactBlueprint, FactS, FactP, FactO, FactAnchor;
+    };
+
+    // 메모리 매핑된 fact DB (읽기 전용). Open 실패 시 IsValid() == false
+    class FFactStoreReader
+    {
+    public:
+        bool Open(const FString& Path)
+        {
+            Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+            if (!Handle) return false;
+            const int64 Size = Handle->GetFileSize();
+            if (Size < (int64)sizeof(FFactStoreHeader)) return false;
+            Region.Reset(Handle->MapRegion(0, Size));
+            if (!Region) return false;
+
+            Base = Region->GetMappedPtr();
+            H = reinterpret_cast<const FFactStoreHeader*>(Base);
+            if (FMemory::Memcmp(H->Magic, FactStoreMagic, sizeof(H->Magic)) != 0 || H->Version != FactStoreVersion) return Fail();
+            for (uint32 S = 0; S < (uint32)EFactStoreSection::Count; ++S)
+            {
+                if (H->Sizes[S] > (uint64)Size || H->Offsets[S] > (uint64)Size - H->Sizes[S]) return Fail();
+                const uint64 Expected = S == (uint32)EFactStoreSection::StrOffsets ? (uint64(H->NumStrings) + 1) * 4
+                    : S == (uint32)EFactStoreSection::StrBlob ? H->Sizes[S] : uint64(H->NumFacts) * 4;
+                if (H->Sizes[S] != Expected) return Fail();
+            }
+            // 문자열 오프셋: 0부터 단조 증가, 끝은 StrBlob 크기
+            if (!Strings.Init(Col(EFactStoreSection::StrOffsets), H->NumStrings,
+                Base + H->Offsets[(uint32)EFactStoreSection::StrBlob], H->Sizes[(uint32)EFactStoreSection::StrBlob])) return Fail();
+            // Match가 돌려주는 행 id도 범위 검사 (문자열 id는 Str()이 막음)
+            auto IdsBelow = [this](EFactStoreSection S, uint32 Num, uint32 Limit)
+                {
+                    const uint32* C = Col(S);
+                    for (uint32 i = 0; i < Num; ++i) if (C[i] >= Limit) return false;
+                    return true;
+                };
+            if (!IdsBelow(EFactStoreSection::SPO, H->NumFacts, H->NumFacts)
+                || !IdsBelow(EFactStoreSection::POS, H->NumFacts, H->NumFacts)
+                || !IdsBelow(EFactStoreSection::OSP, H->NumFacts, H->NumFacts)) return Fail();
+            return true;
+        }
+
+        bool IsValid() const { return H != nullptr; }
+        const FFactStoreHeader& Header() const { return *H; }
+
+        FString Str(uint32 Id) const { return Strings.Str(Id); }
+
+        // 대소문자 무시로 S와 같은 문자열들의 id 구간
+        FStringIdRun FindStrings(const FString& S) const { return Strings.FindStrings(S); }
+
+        // 문자열 id로 조회, INDEX_NONE = 미지정. 셋 다 미지정이면 전체 (SPO 순)
+        // 지정된 값의 조합이 항상 어느 한 인덱스의 접두사가 되도록 인덱스를 고름
+        TConstArrayView<uint32> Match(int32 S, int32 P, int32 O) const
+        {
+            const bool bS = S != INDEX_NONE, bP = P != INDEX_NONE, bO = O != INDEX_NONE;
+            if (bP && !bS)       return Range(EFactStoreSection::POS, EFactStoreSection::FactP, EFactStoreSection::FactO, P, O);
+            if (bO && !bP)       return Range(EFactStoreSection::OSP, EFactStoreSection::FactO, EFactStoreSection::FactS, O, S);
+            return Range3(S, P, O);
+        }
+
+        // 구간 버전: 각 구간의 id 조합마다 Match (대소문자만 다른 문자열은 드물어 보통 1회)
+        // 미지정은 INDEX_NONE 하나로 취급
+        void Match(const FStringIdRun* S, const FStringIdRun* P, const FStringIdRun* O, TArray<uint32>& Out) const
+        {
+            const FStringIdRun None{ INDEX_NONE, 1 };
+            const FStringIdRun& RS = S ? *S : None;
+            const FStringIdRun& RP = P ? *P : None;
+            const FStringIdRun& RO = O ? *O : None;
+            for (int32 s = RS.First; s < RS.End(); ++s)
+                for (int32 p = RP.First; p < RP.End(); ++p)
+                    for (int32 o = RO.First; o < RO.End(); ++o)
+                        Out.Append(Match(s, p, o));
+        }
+
+        uint32 Fact(EFactStoreSection Column, uint32 Row) const { return Col(Column)[Row]; }
+
+    private:
+        bool Fail() { H = nullptr; Strings = FSortedStringTableView(); return false; }
+
+        const uint32* Col(EFactStoreSection S) const { return reinterpret_cast<const uint32*>(Base + H->Offsets[(uint32)S]); }
+
+        // Index가 (K1, K2, ...) 순으로 정렬돼 있을 때 K1 == V1 (그리고 V2 != NONE이면 K2 == V2)인 구간
+        TConstArrayView<uint32> Range(EFactStoreSection IndexSec, EFactStoreSection K1, EFactStoreSection K2, int32 V1, int32 V2) const
+        {
+            const uint32* Index = Col(IndexSec);
+            const uint32* C1 = Col(K1);
+            const uint32* C2 = Col(K2);
+            const bool bTwo = V2 != INDEX_NONE;
+            // Cmp(row) < 0: 구간 앞, 0: 구간 안, > 0: 구간 뒤
+            auto Cmp = [&](uint32 Row) -> int32
+                {
+                    if (C1[Row] != (uint32)V1) return C1[Row] < (uint32)V1 ? -1 : 1;
+                    if (bTwo && C2[Row] != (uint32)V2) return C2[Row] < (uint32)V2 ? -1 : 1;
+                    return 0;
+                };
+            return Bounds(Index, Cmp);
+        }
+
+        // SPO: s(, p(, o)) 접두사. s 미지정이면 전체
+        TConstArrayView<uint32> Range3(int32 S, int32 P, int32 O) const
+        {
+            const uint32* Index = Col(EFactStoreSection::SPO);
+            if (S == INDEX_NONE) return TConstArrayView<uint32>(Index, (int32)H->NumFacts);
+            const uint32* CS = Col(EFactStoreSection::FactS);
+            const uint32* CP = Col(EFactStoreSection::FactP);
+            const uint32* CO = Col(EFactStoreSection::FactO);
+            auto Cmp = [&](uint32 Row) -> int32
+                {
+                    if (CS[Row] != (uint32)S) return CS[Row] < (uint32)S ? -1 : 1;
+                    if (P == INDEX_NONE) return 0;
+                    if (CP[Row] != (uint32)P) return CP[Row] < (uint32)P ? -1 : 1;
+                    if (O == INDEX_NONE) return 0;
+                    if (CO[Row] != (uint32)O) return CO[Row] < (uint32)O ? -1 : 1;
+                    return 0;
+                };
+            return Bounds(Index, Cmp);
+        }
+
+        template <typename CmpType>
+        TConstArrayView<uint32> Bounds(const uint32* Index, const CmpType& Cmp) const
+        {
+            int32 Lo = 0, Hi = (int32)H->NumFacts;
+            while (Lo < Hi) { const int32 Mid = Lo + (Hi - Lo) / 2; if (Cmp(Index[Mid]) < 0) Lo = Mid + 1; else Hi = Mid; }
+            const int32 First = Lo;
+            Hi = (int32)H->NumFacts;
+            while (Lo < Hi) { const int32 Mid = Lo + (Hi - Lo) / 2; if (Cmp(Index[Mid]) <= 0) Lo = Mid + 1; else Hi = Mid; }
+            return TConstArrayView<uint32>(Index + First, Lo - First);
+        }
+
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+        const uint8* Base = nullptr;
+        const FFactStoreHeader* H = nullptr;
+        FSortedStringTableView Strings;
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "BTD_GraphIR.h"
+
+namespace BTD
+{
+    static constexpr uint32 FactTableMagic = 0x54465442; // "BTFT"
+    static constexpr uint32 FactTableVersion = 1;
+
+    // Per-Blueprint fact table (s, p, o + evidence anchors).
+    // Subjects, predicates, objects and anchors are interned (case-sensitive, id 0 = "").
+    // A triple that is added again (e.g. depends_on for every call site of the same function)
+    // keeps its first position and only merges the new evidence.
+    class FFactTable
+    {
+    public:
+        struct FFact
+        {
+            int32 S = 0, P = 0, O = 0;
+            TArray<int32, TInlineAllocator<2>> Ev; // 중복 없음, 추가 순서
+        };
+
+        void Add(const FString& S, const FString& P, const FString& O, std::initializer_list<FString> Ev)
+        {
+            FFact& F = FindOrAdd(S, P, O);
+            for (const FString& A : Ev) F.Ev.AddUnique(Strings.Intern(A));
+        }
+
+        int32 Num() const                  { return Facts.Num(); }
+        const FFact& operator[](int32 i) const { return Facts[i]; }
+        const FString& Str(int32 Id) const { return Strings[Id]; }
+        int32 NumStrings() const           { return Strings.Num(); }
+        int32 NumMerged() const            { return Merged; }
+
+        // 근거 앵커 id를 문자열 순서로 (기존 NDJSON 출력과 같은 정렬)
+        void SortedEvidence(const FFact& F, TArray<int32, TInlineAllocator<8>>& Out) const
+        {
+            Out.Reset();
+            Out.Append(F.Ev);
+            Out.Sort([this](int32 A, int32 B) { return Strings[A] < Strings[B]; });
+        }
+
+        // 바이너리 형식 (<BP>.bpfacts.bin): 문자열 테이블 + s/p/o 열 + 근거 CSR
+        void Serialize(FArchive& Ar) const
+        {
+            check(Ar.IsSaving());
+            uint32 Magic = FactTableMagic, Version = FactTableVersion;
+            Ar << Magic << Version;
+
+            int32 NumStr = Strings.Num();
+            Ar << NumStr;
+            for (int32 i = 0; i < NumStr; ++i)
+            {
+                FString S = Strings[i];
+                Ar << S;
+            }
+
+            TArray<int32> Cols[3];
+            TArray<int32> EvOffsets, EvIds;
+            EvOffsets.Reserve(Facts.Num() + 1);
+            EvOffsets.Add(0);
+            for (const FFact& F : Facts)
+            {
+                Cols[0].Add(F.S); Cols[1].Add(F.P); Cols[2].Add(F.O);
+                EvIds.Append(F.Ev);
+                EvOffsets.Add(EvIds.Num());
+            }
+            Ar << Cols[0] << Cols[1] << Cols[2] << EvOffsets << EvIds;
+        }
+
+    private:
+        FFact& FindOrAdd(const FString& S, const FString& P, const FString& O)
+        {
+            const FIntVector Key(Strings.Intern(S), Strings.Intern(P), Strings.Intern(O));
+            if (const int32* Found = Index.Find(Key))
+            {
+                ++Merged;
+                return Facts[*Found];
+            }
+            const int32 Id = Facts.AddDefaulted();
+            Facts[Id].S = Key.X; Facts[Id].P = Key.Y; Facts[Id].O = Key.Z;
+            Index.Add(Key, Id);
+            return Facts[Id];
+        }
+
+        FStringPool Strings;
+        TArray<FFact> Facts;
+        TMap<FIntVector, int32> Index; // (s, p, o) → Facts 인덱스
+        int32 Merged = 0;
+    };
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+
+// Function classification for the fact / def-use / lint heuristics.
+// The name checks (SetText, SetVisibility, GetAllActorsOfClass, Array_Get, comparisons,
+// Set/Get property accessors ...) are evaluated once per UFunction and cached for the editor
+// session; graph capture stores the resulting bitmask and property name in the IR, so the
+// worker-side loops test bits instead of scanning strings.
+namespace BTD
+{
+    enum EFunctionClass : uint32
+    {
+        FC_SetText             = 1 << 0,
+        FC_SetVisibility       = 1 << 1,
+        FC_SetIsEnabled        = 1 << 2,
+        FC_AddChild            = 1 << 3,   // PanelWidget::AddChild 계열 (AddChildTo... 포함)
+        FC_ClearChildren       = 1 << 4,
+        FC_Compare             = 1 << 5,   // EqualEqual* / Greater* / Less*
+        FC_GetAllActorsOfClass = 1 << 6,
+        FC_ArrayGet            = 1 << 7,
+        FC_PropertySetter      = 1 << 8,   // SetXxx → Property "Xxx"
+        FC_PropertyGetter      = 1 << 9,   // GetXxx → Property "Xxx"
+    };
+
+    struct FFunctionClassInfo
+    {
+        uint32 Mask = 0;
+        FString Property;   // FC_PropertySetter / FC_PropertyGetter일 때만
+    };
+
+    // 이름 → 분류 (대소문자 무시, 기존 Contains/StartsWith와 같은 규칙)
+    inline FFunctionClassInfo ClassifyFunctionName(const FString& Fn)
+    {
+        FFunctionClassInfo Info;
+        if (Fn.Contains(TEXT("SetText")))             Info.Mask |= FC_SetText;
+        if (Fn.Contains(TEXT("SetVisibility")))       Info.Mask |= FC_SetVisibility;
+        if (Fn.Contains(TEXT("SetIsEnabled")))        Info.Mask |= FC_SetIsEnabled;
+        if (Fn.StartsWith(TEXT("AddChild")))          Info.Mask |= FC_AddChild;
+        if (Fn.Contains(TEXT("ClearChildren")))       Info.Mask |= FC_ClearChildren;
+        if (Fn.StartsWith(TEXT("EqualEqual")) || Fn.StartsWith(TEXT("Greater")) || Fn.StartsWith(TEXT("Less")))
+            Info.Mask |= FC_Compare;
+        if (Fn.Contains(TEXT("GetAllActorsOfClass"))) Info.Mask |= FC_GetAllActorsOfClass;
+        if (Fn.Contains(TEXT("Array_Get")))           Info.Mask |= FC_ArrayGet;
+
+        // 함수명에서 속성명/읽기·쓰기 유형: SetXxx → write "Xxx", GetYyy → read "Yyy"
+        // (K2_SetRelativeLocation 같은 예외가 필요하면 여기서 규칙 추가)
+        if (Fn.Len() > 3 && (Fn.StartsWith(TEXT("Set")) || Fn.StartsWith(TEXT("Get"))))
+        {
+            Info.Mask |= (Fn[0] == TCHAR('S') || Fn[0] == TCHAR('s')) ? FC_PropertySetter : FC_PropertyGetter;
+            Info.Property = Fn.Mid(3);
+        }
+        return Info;
+    }
+
+    // UFunction별 분류 캐시 (에디터 세션 동안 유지, 스레드 안전).
+    // FObjectKey 키라서 GC 후 같은 주소에 다른 함수가 와도 섞이지 않음
+    class FFunctionClassCache
+    {
+    public:
+        static FFunctionClassCache& Get()
+        {
+            static FFunctionClassCache Instance;
+            return Instance;
+        }
+
+        FFunctionClassInfo Find(const UFunction* Fn)
+        {
+            if (!Fn) return FFunctionClassInfo();
+            const FObjectKey Key(Fn);
+            {
+                FReadScopeLock Lock(RWLock);
+                if (const FFunctionClassInfo* Found = Entries.Find(Key)) return *Found;
+            }
+            FFunctionClassInfo Info = ClassifyFunctionName(Fn->GetName());
+            FWriteScopeLock Lock(RWLock);
+            return Entries.FindOrAdd(Key, MoveTemp(Info));
+        }
+
+        int32 Num() const
+        {
+            FReadScopeLock Lock(RWLock);
+            return Entries.Num();
+        }
+
+    private:
+        mutable FRWLock RWLock;
+        TMap<FObjectKey, FFunctionClassInfo> Entries;
+    };
+}
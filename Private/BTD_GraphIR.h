@@ -0,0 +1,309 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Misc/Crc.h"
+#include <atomic>
+
+class UEdGraphNode;
+
+// Engine-object-free snapshot of one UEdGraph.
+// Captured once on the game thread; every emitter (flow JSON/DSL, slices, facts,
+// def-use, lint) reads only this, so emission can run on worker threads.
+namespace BTD
+{
+    // FString/FName keys in TMap are case-insensitive by default; pin and graph names are not.
+    struct FCaseSensitiveStringKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+    {
+        static FORCEINLINE bool Matches(KeyInitType A, KeyInitType B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static FORCEINLINE uint32 GetKeyHash(KeyInitType Key) { return FCrc::StrCrc32(*Key); }
+    };
+
+    struct FCaseSensitiveNameKeyFuncs : TDefaultMapKeyFuncs<FName, int32, false>
+    {
+        static FORCEINLINE bool Matches(KeyInitType A, KeyInitType B) { return A.IsEqual(B, ENameCase::CaseSensitive); }
+        static FORCEINLINE uint32 GetKeyHash(KeyInitType Key) { return GetTypeHash(Key); }
+    };
+
+    // Interned strings with dense ids. Id 0 is always "".
+    class FStringPool
+    {
+    public:
+        FStringPool() { Strings.Add(FString()); }
+
+        int32 Intern(const FString& S)
+        {
+            if (S.IsEmpty()) return 0;
+            if (const int32* Found = Index.Find(S)) return *Found;
+            const int32 Id = Strings.Add(S);
+            Index.Add(S, Id);
+            return Id;
+        }
+
+        // NAME_None interns as "None" (same as FName::ToString()).
+        int32 Intern(FName N)
+        {
+            if (const int32* Found = NameIndex.Find(N)) return *Found;
+            const int32 Id = Intern(N.ToString());
+            NameIndex.Add(N, Id);
+            return Id;
+        }
+
+        const FString& operator[](int32 Id) const { return Strings[Id]; }
+        int32 Num() const { return Strings.Num(); }
+
+    private:
+        TArray<FString> Strings;
+        TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> Index;
+        TMap<FName, int32, FDefaultSetAllocator, FCaseSensitiveNameKeyFuncs> NameIndex;
+    };
+
+    // Consecutive ids of a store string table (sorted case-insensitively) that equal one
+    // query string ignoring case. Num == 0: not found.
+    struct FStringIdRun
+    {
+        int32 First = 0;
+        int32 Num = 0;
+
+        bool IsEmpty() const { return Num == 0; }
+        int32 End() const    { return First + Num; }
+    };
+
+    // Per-Blueprint anchor table. Each node's anchor is computed once during capture and
+    // shared by every emitter of that Blueprint; "@"-prefixed evidence keys are kept alongside.
+    // Node keys are only used on the game thread. After capture the table is read-only, but
+    // lint reads it from several graphs in parallel, so the reuse counter is atomic.
+    class FAnchorTable
+    {
+    public:
+        // Id for Node, calling Make() only the first time Node is seen.
+        template <typename FnType>
+        int32 FindOrAdd(const UEdGraphNode* Node, FnType&& Make)
+        {
+            if (const int32* Found = Ids.Find(Node)) { CountHit(); return *Found; }
+            ++Misses;
+            const int32 Id = Anchors.Add(Make());
+            Keys.Add(TEXT("@") + Anchors[Id]);
+            Ids.Add(Node, Id);
+            return Id;
+        }
+
+        const FString& Anchor(int32 Id) const { CountHit(); return Anchors[Id]; }   // "A" + 10 hex
+        const FString& Key(int32 Id) const    { CountHit(); return Keys[Id]; }      // "@A..."
+
+        int32 Num() const       { return Anchors.Num(); }
+        int32 GetHits() const   { return Hits.load(std::memory_order_relaxed); }
+        int32 GetMisses() const { return Misses; }
+
+    private:
+        void CountHit() const { Hits.fetch_add(1, std::memory_order_relaxed); }
+
+        TArray<FString> Anchors;
+        TArray<FString> Keys;
+        TMap<const UEdGraphNode*, int32> Ids;
+        mutable std::atomic<int32> Hits{ 0 };
+        int32 Misses = 0;
+    };
+
+    enum class ENodeKind : uint8
+    {
+        Other,
+        CallFunction,
+        MacroInstance,
+        CustomEvent,
+        Event,
+        VariableGet,
+        VariableSet,
+        Variable,       // other UK2Node_Variable subclasses
+        Knot,
+        FunctionEntry,
+    };
+
+    enum ENodeFlags : uint16
+    {
+        NF_HasFunction   = 1 << 0,  // CallFunction with a resolved UFunction
+        NF_FnConst       = 1 << 1,
+        NF_FnStatic      = 1 << 2,
+        NF_Pure          = 1 << 3,
+        NF_SelfContext   = 1 << 4,
+        NF_HasMacroGraph = 1 << 5,
+        NF_Branch        = 1 << 6,  // class name contains K2Node_IfThenElse
+        NF_DynamicCast   = 1 << 7,  // class name contains K2Node_DynamicCast
+    };
+
+    enum EPinFlags : uint8
+    {
+        PF_Input  = 1 << 0,
+        PF_Exec   = 1 << 1,
+        PF_ByRef  = 1 << 2,
+        PF_Linked = 1 << 3,         // raw LinkedTo.Num() > 0
+    };
+
+    // Structure-of-arrays node/pin/link tables with dense indices.
+    // Nodes are in UEdGraph::Nodes order (valid nodes only); Sorted holds the (PosY, PosX) order.
+    struct FGraphIR
+    {
+        FStringPool Strings;
+        int32 Name = 0;
+        const FAnchorTable* Anchors = nullptr;  // owned by the Blueprint's dump job
+
+        // nodes
+        TArray<FGuid>     NodeGuid;
+        TArray<int32>     NodeClass;
+        TArray<int32>     NodeTitle;         // FullTitle
+        TArray<int32>     NodeListTitle;     // ListView title
+        TArray<int32>     NodeComment;
+        TArray<int32>     NodePosX;
+        TArray<int32>     NodePosY;
+        TArray<ENodeKind> NodeKind;
+        TArray<uint16>    NodeFlags;
+        TArray<int32>     NodeFunc;          // function name
+        TArray<int32>     NodeFuncOwnerPath;
+        TArray<int32>     NodeFuncOwnerName;
+        TArray<uint32>    NodeFuncClass;     // EFunctionClass bits (BTD_FunctionClass.h)
+        TArray<int32>     NodeFuncProp;      // Set/Get accessor → property name
+        TArray<int32>     NodeCallee;        // self-context call → function graph name
+        TArray<int32>     NodeMember;        // event / custom event / macro graph name
+        TArray<int32>     NodeMacroSource;   // macro source BP path
+        TArray<int32>     NodeVar;           // UK2Node_Variable var name (0 = none)
+        TArray<int32>     NodeAnchor;        // id in Anchors
+        TArray<int32>     NodeFirstPin;
+        TArray<int32>     NodeNumPins;
+        TArray<int32>     Sorted;
+
+        // pins
+        TArray<int32> PinNode;
+        TArray<int32> PinName;
+        TArray<int32> PinCategory;
+        TArray<int32> PinSubCategory;
+        TArray<int32> PinDefault;            // DefaultValue
+        TArray<int32> PinDefaultText;        // DefaultTextValue
+        TArray<int32> PinDefaultObject;      // DefaultObject path
+        TArray<uint8> PinFlags;
+        TArray<int32> PinFirstLink;
+        TArray<int32> PinNumLinks;
+
+        // links: target pin index, grouped per source pin in LinkedTo order
+        TArray<int32> LinkPin;
+
+        const FString& Str(int32 Id) const { return Strings[Id]; }
+        int32 NumNodes() const { return NodeGuid.Num(); }
+        int32 NumPins() const  { return PinNode.Num(); }
+
+        int32 AddNode()
+        {
+            NodeGuid.AddDefaulted();
+            NodeClass.Add(0); NodeTitle.Add(0); NodeListTitle.Add(0); NodeComment.Add(0);
+            NodePosX.Add(0); NodePosY.Add(0);
+            NodeKind.Add(ENodeKind::Other); NodeFlags.Add(0);
+            NodeFunc.Add(0); NodeFuncOwnerPath.Add(0); NodeFuncOwnerName.Add(0);
+            NodeFuncClass.Add(0); NodeFuncProp.Add(0);
+            NodeCallee.Add(0); NodeMember.Add(0); NodeMacroSource.Add(0); NodeVar.Add(0);
+            NodeAnchor.Add(INDEX_NONE);
+            NodeFirstPin.Add(PinNode.Num()); NodeNumPins.Add(0);
+            return NodeGuid.Num() - 1;
+        }
+
+        int32 AddPin(int32 Node)
+        {
+            PinNode.Add(Node);
+            PinName.Add(0); PinCategory.Add(0); PinSubCategory.Add(0);
+            PinDefault.Add(0); PinDefaultText.Add(0); PinDefaultObject.Add(0);
+            PinFlags.Add(0);
+            PinFirstLink.Add(LinkPin.Num()); PinNumLinks.Add(0);
+            ++NodeNumPins[Node];
+            return PinNode.Num() - 1;
+        }
+
+        const FString& Anchor(int32 Node) const    { return Anchors->Anchor(NodeAnchor[Node]); }
+        const FString& AnchorKey(int32 Node) const { return Anchors->Key(NodeAnchor[Node]); }
+
+        bool HasFlag(int32 Node, uint16 Flag) const { return (NodeFlags[Node] & Flag) != 0; }
+        bool IsFunc(int32 Node, uint32 FuncClass) const { return (NodeFuncClass[Node] & FuncClass) != 0; }
+        bool IsVariableNode(int32 Node) const
+        {
+            const ENodeKind K = NodeKind[Node];
+            return K == ENodeKind::VariableGet || K == ENodeKind::VariableSet || K == ENodeKind::Variable;
+        }
+
+        bool IsInput(int32 Pin) const     { return (PinFlags[Pin] & PF_Input) != 0; }
+        bool IsExec(int32 Pin) const      { return (PinFlags[Pin] & PF_Exec) != 0; }
+        bool IsLinked(int32 Pin) const    { return (PinFlags[Pin] & PF_Linked) != 0; }
+        bool IsDataInput(int32 Pin) const { return IsInput(Pin) && !IsExec(Pin); }
+
+        TArrayView<const int32> Links(int32 Pin) const
+        {
+            return TArrayView<const int32>(LinkPin.GetData() + PinFirstLink[Pin], PinNumLinks[Pin]);
+        }
+
+        // First input pin whose name matches (case-insensitive). INDEX_NONE if absent.
+        int32 FindInputPin(int32 Node, const TCHAR* NameA, const TCHAR* NameB = nullptr) const
+        {
+            for (int32 P = NodeFirstPin[Node], E = P + NodeNumPins[Node]; P < E; ++P)
+            {
+                if (!IsInput(P)) continue;
+                const FString& Nm = Str(PinName[P]);
+                if (Nm.Equals(NameA, ESearchCase::IgnoreCase) || (NameB && Nm.Equals(NameB, ESearchCase::IgnoreCase)))
+                    return P;
+            }
+            return INDEX_NONE;
+        }
+
+        // Text default first, then string default.
+        FString PinDefaultOrText(int32 Pin) const
+        {
+            if (Pin == INDEX_NONE) return TEXT("");
+            if (PinDefaultText[Pin]) return Str(PinDefaultText[Pin]);
+            if (PinDefault[Pin])     return Str(PinDefault[Pin]);
+            return TEXT("");
+        }
+
+        // Follow links back to a VariableGet, passing through reroute (Knot) nodes.
+        // Returns the interned var name id, 0 if none.
+        int32 ObjectVarNameFromInputPin(int32 Pin) const
+        {
+            if (Pin == INDEX_NONE) return 0;
+
+            TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> Visited;
+            TArray<int32, TInlineAllocator<16>> Stack;
+            for (const int32 L : Links(Pin)) Stack.Add(L);
+
+            while (Stack.Num() > 0)
+            {
+                const int32 P = Stack.Last();
+                Stack.RemoveAt(Stack.Num() - 1, 1, EAllowShrinking::No);
+
+                bool bAlready = false;
+                Visited.Add(P, &bAlready);
+                if (bAlready) continue;
+
+                const int32 Node = PinNode[P];
+                if (NodeKind[Node] == ENodeKind::VariableGet && NodeVar[Node] != 0)
+                    return NodeVar[Node];
+
+                if (NodeKind[Node] == ENodeKind::Knot)
+                {
+                    for (int32 KP = NodeFirstPin[Node], E = KP + NodeNumPins[Node]; KP < E; ++KP)
+                    {
+                        if (!IsInput(KP)) continue;
+                        for (const int32 L2 : Links(KP)) Stack.Add(L2);
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // Call target object var: "self" pin first, then "Target". 0 if unresolved.
+        int32 CallTargetObjectVarName(int32 Node) const
+        {
+            int32 SelfPin = INDEX_NONE, TargetPin = INDEX_NONE;
+            for (int32 P = NodeFirstPin[Node], E = P + NodeNumPins[Node]; P < E; ++P)
+            {
+                if (!IsInput(P)) continue;
+                const FString& N = Str(PinName[P]);
+                if (N.Equals(TEXT("self"), ESearchCase::IgnoreCase))        SelfPin = P;
+                else if (N.Equals(TEXT("Target"), ESearchCase::IgnoreCase)) TargetPin = P;
+            }
+            if (const int32 V = ObjectVarNameFromInputPin(SelfPin)) return V;
+            return ObjectVarNameFromInputPin(TargetPin);
+        }
+    };
+}
@@ -0,0 +1,410 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Serialization/MemoryReader.h"
+#include "Algo/BinarySearch.h"
+#include "BTD_GraphIR.h"
+#include "BTD_StringTable.h"
+
+// Columnar project graph store (project_graph.btdstore) for BP.Query.
+//
+// Every dump writes a small per-Blueprint fragment (<BP>.bpstore) straight from the graph IR.
+// BP.ProjectRefs Store concatenates the fragments of all Blueprints into one file:
+// a sorted string table plus node / pin / edge columns and two lookup indexes
+// (nodes by function name, nodes by variable name). BP.Query memory-maps that file and
+// answers with binary searches; no JSON is parsed at query time.
+namespace BTD
+{
+    // ---------------- per-Blueprint fragment ----------------
+
+    static constexpr uint32 GraphFragmentMagic = 0x46445442; // "BTDF"
+    static constexpr uint32 GraphFragmentVersion = 1;
+
+    // 조각 하나 = BP 하나. 문자열 id는 조각 안에서만 유효 (0 = "")
+    struct FGraphFragment
+    {
+        FString BlueprintPath;
+        TArray<FString> Strings;
+
+        TArray<int32> NodeGraph, NodeFunc, NodeOwner, NodeVar, NodeTitle, NodeAnchor;
+        TArray<uint8> NodeKind;
+
+        TArray<int32> PinNode, PinName, PinCategory, PinDefaultObject;
+        TArray<uint8> PinFlags;
+
+        TArray<int32> EdgeFrom, EdgeTo;     // output pin → input pin
+
+        void Serialize(FArchive& Ar)
+        {
+            uint32 Magic = GraphFragmentMagic, Version = GraphFragmentVersion;
+            Ar << Magic << Version;
+            if (Ar.IsLoading() && (Magic != GraphFragmentMagic || Version != GraphFragmentVersion))
+            {
+                Ar.SetError();
+                return;
+            }
+            Ar << BlueprintPath << Strings;
+            Ar << NodeGraph << NodeFunc << NodeOwner << NodeVar << NodeTitle << NodeAnchor << NodeKind;
+            Ar << PinNode << PinName << PinCategory << PinDefaultObject << PinFlags;
+            Ar << EdgeFrom << EdgeTo;
+        }
+
+        void Build(const FString& InBlueprintPath, const TArray<FGraphIR>& Graphs)
+        {
+            BlueprintPath = InBlueprintPath;
+            FStringPool Pool;
+            for (const FGraphIR& G : Graphs)
+            {
+                const int32 NodeBase = NodeGraph.Num();
+                const int32 PinBase = PinNode.Num();
+                const int32 GraphName = Pool.Intern(G.Str(G.Name));
+
+                for (int32 N = 0; N < G.NumNodes(); ++N)
+                {
+                    NodeGraph.Add(GraphName);
+                    NodeKind.Add(uint8(G.NodeKind[N]));
+                    NodeFunc.Add(Pool.Intern(G.Str(G.NodeFunc[N])));
+                    NodeOwner.Add(Pool.Intern(G.Str(G.NodeFuncOwnerName[N])));
+                    NodeVar.Add(Pool.Intern(G.Str(G.NodeVar[N])));
+                    NodeTitle.Add(Pool.Intern(G.Str(G.NodeTitle[N])));
+                    NodeAnchor.Add(G.Anchors ? Pool.Intern(G.Anchors->Anchor(G.NodeAnchor[N])) : 0);
+                }
+                for (int32 P = 0; P < G.NumPins(); ++P)
+                {
+                    PinNode.Add(NodeBase + G.PinNode[P]);
+                    PinName.Add(Pool.Intern(G.Str(G.PinName[P])));
+                    PinCategory.Add(Pool.Intern(G.Str(G.PinCategory[P])));
+                    PinDefaultObject.Add(Pool.Intern(G.Str(G.PinDefaultObject[P])));
+                    PinFlags.Add(G.PinFlags[P]);
+
+                    // 링크는 양쪽 핀에 모두 있으므로 출력 핀 쪽만 기록
+                    if (G.IsInput(P)) continue;
+                    for (const int32 L : G.Links(P))
+                    {
+                        EdgeFrom.Add(PinBase + P);
+                        EdgeTo.Add(PinBase + L);
+                    }
+                }
+            }
+            Strings.SetNum(Pool.Num());
+            for (int32 i = 0; i < Pool.Num(); ++i) Strings[i] = Pool[i];
+        }
+    };
+
+    // Ar: 저장용 아카이브 (FUtf8Builder도 가능)
+    inline void BuildGraphFragment(const FString& BlueprintPath, const TArray<FGraphIR>& Graphs, FArchive& Ar)
+    {
+        FGraphFragment F;
+        F.Build(BlueprintPath, Graphs);
+        F.Serialize(Ar);
+    }
+
+    // 깨진/다른 버전 조각은 false (id 범위와 열 길이까지 검사)
+    inline bool LoadGraphFragment(const TArray<uint8>& Bytes, FGraphFragment& Out)
+    {
+        FMemoryReader Ar(Bytes);
+        Out.Serialize(Ar);
+        if (Ar.IsError()) return false;
+
+        const int32 NS = Out.Strings.Num(), NN = Out.NodeGraph.Num(), NP = Out.PinNode.Num();
+        auto IdsOk = [](const TArray<int32>& Col, int32 Limit)
+            {
+                for (const int32 Id : Col) if (Id < 0 || Id >= Limit) return false;
+                return true;
+            };
+        for (const TArray<int32>* Col : { &Out.NodeFunc, &Out.NodeOwner, &Out.NodeVar, &Out.NodeTitle, &Out.NodeAnchor })
+        {
+            if (Col->Num() != NN) return false;
+        }
+        for (const TArray<int32>* Col : { &Out.PinName, &Out.PinCategory, &Out.PinDefaultObject })
+        {
+            if (Col->Num() != NP) return false;
+        }
+        return NS > 0 && Out.NodeKind.Num() == NN && Out.PinFlags.Num() == NP && Out.EdgeFrom.Num() == Out.EdgeTo.Num()
+            && IdsOk(Out.NodeGraph, NS) && IdsOk(Out.NodeFunc, NS) && IdsOk(Out.NodeOwner, NS) && IdsOk(Out.NodeVar, NS)
+            && IdsOk(Out.NodeTitle, NS) && IdsOk(Out.NodeAnchor, NS)
+            && IdsOk(Out.PinName, NS) && IdsOk(Out.PinCategory, NS) && IdsOk(Out.PinDefaultObject, NS)
+            && IdsOk(Out.PinNode, NN) && IdsOk(Out.EdgeFrom, NP) && IdsOk(Out.EdgeTo, NP);
+    }
+
+    // ---------------- project store file ----------------
+
+    enum class EGraphStoreSection : uint32
+    {
+        StrOffsets,         // uint32[NumStrings + 1], byte offsets into StrBlob
+        StrBlob,            // UTF-8, strings sorted case-insensitively, then case-sensitively (id 0 = "")
+        BlueprintPath,      // uint32[NumBlueprints]
+        NodeBlueprint,      // uint32[NumNodes] ...
+        NodeGraph,
+        NodeKind,           // uint8
+        NodeFunc,
+        NodeOwner,
+        NodeVar,
+        NodeTitle,
+        NodeAnchor,
+        PinNode,            // uint32[NumPins] ...
+        PinName,
+        PinCategory,
+        PinDefaultObject,
+        PinFlags,           // uint8
+        EdgeFrom,           // uint32[NumEdges]
+        EdgeTo,
+        FuncIndex,          // node ids with a function, sorted by (NodeFunc, node)
+        VarIndex,           // node ids with a variable, sorted by (NodeVar, node)
+        Count
+    };
+
+    struct FGraphStoreHeader
+    {
+        uint8  Magic[8];
+        uint32 Version;
+        uint32 NumStrings;
+        uint32 NumBlueprints;
+        uint32 NumNodes;
+        uint32 NumPins;
+        uint32 NumEdges;
+        uint32 NumFuncIndex;
+        uint32 NumVarIndex;
+        uint64 Offsets[(uint32)EGraphStoreSection::Count];
+        uint64 Sizes[(uint32)EGraphStoreSection::Count];
+    };
+
+    static constexpr uint8 GraphStoreMagic[8] = { 'B', 'T', 'D', 'G', 'S', 'T', 'O', 'R' };
+    static constexpr uint32 GraphStoreVersion = 1;
+
+    // 조각들을 모아 하나의 저장소 파일 바이트로 만든다 (문자열 전역 정렬 + id 재매핑 + 인덱스)
+    class FGraphStoreWriter
+    {
+    public:
+        void Add(const FGraphFragment& F)
+        {
+            TArray<uint32> Remap;
+            Remap.SetNumUninitialized(F.Strings.Num());
+            for (int32 i = 0; i < F.Strings.Num(); ++i) Remap[i] = Strings.Intern(F.Strings[i]);
+
+            const uint32 BP = BlueprintPath.Add(Strings.Intern(F.BlueprintPath));
+            const uint32 NodeBase = NodeGraph.Num();
+            const uint32 PinBase = PinNode.Num();
+            for (int32 N = 0; N < F.NodeGraph.Num(); ++N)
+            {
+                NodeBlueprint.Add(BP);
+                NodeGraph.Add(Remap[F.NodeGraph[N]]);
+                NodeKind.Add(F.NodeKind[N]);
+                NodeFunc.Add(Remap[F.NodeFunc[N]]);
+                NodeOwner.Add(Remap[F.NodeOwner[N]]);
+                NodeVar.Add(Remap[F.NodeVar[N]]);
+                NodeTitle.Add(Remap[F.NodeTitle[N]]);
+                NodeAnchor.Add(Remap[F.NodeAnchor[N]]);
+            }
+            for (int32 P = 0; P < F.PinNode.Num(); ++P)
+            {
+                PinNode.Add(NodeBase + F.PinNode[P]);
+                PinName.Add(Remap[F.PinName[P]]);
+                PinCategory.Add(Remap[F.PinCategory[P]]);
+                PinDefaultObject.Add(Remap[F.PinDefaultObject[P]]);
+                PinFlags.Add(F.PinFlags[P]);
+            }
+            for (int32 E = 0; E < F.EdgeFrom.Num(); ++E)
+            {
+                EdgeFrom.Add(PinBase + F.EdgeFrom[E]);
+                EdgeTo.Add(PinBase + F.EdgeTo[E]);
+            }
+        }
+
+        int32 NumBlueprints() const { return BlueprintPath.Num(); }
+        int32 NumNodes() const      { return NodeGraph.Num(); }
+
+        void Finish(TArray<uint8>& Out)
+        {
+            // 임시 id를 정렬 순위로 바꿈. 대소문자만 다른 문자열은 연속된 id → 인덱스에서도 연속 구간
+            const int32 NS = Strings.Num();
+            TArray<uint32> Rank, StrOffsets;
+            TArray<uint8> StrBlob;
+            Strings.Finish(Rank, StrOffsets, StrBlob);
+            for (TArray<uint32>* Col : { &BlueprintPath, &NodeGraph, &NodeFunc, &NodeOwner, &NodeVar, &NodeTitle, &NodeAnchor,
+                                         &PinName, &PinCategory, &PinDefaultObject })
+            {
+                for (uint32& Id : *Col) Id = Rank[Id];
+            }
+
+            TArray<uint32> FuncIndex = MakeIndex(NodeFunc);
+            TArray<uint32> VarIndex = MakeIndex(NodeVar);
+
+            FGraphStoreHeader H;
+            FMemory::Memzero(H);
+            FMemory::Memcpy(H.Magic, GraphStoreMagic, sizeof(H.Magic));
+            H.Version = GraphStoreVersion;
+            H.NumStrings = NS;
+            H.NumBlueprints = BlueprintPath.Num();
+            H.NumNodes = NodeGraph.Num();
+            H.NumPins = PinNode.Num();
+            H.NumEdges = EdgeFrom.Num();
+            H.NumFuncIndex = FuncIndex.Num();
+            H.NumVarIndex = VarIndex.Num();
+
+            Out.Reset();
+            Out.AddZeroed(sizeof(FGraphStoreHeader));
+            auto Put = [&](EGraphStoreSection S, const void* Data, int64 Size)
+                {
+                    Out.AddZeroed(Align(Out.Num(), 8) - Out.Num());
+                    H.Offsets[(uint32)S] = Out.Num();
+                    H.Sizes[(uint32)S] = Size;
+                    Out.Append((const uint8*)Data, Size);
+                };
+            auto PutCol = [&](EGraphStoreSection S, const auto& Col) { Put(S, Col.GetData(), Col.Num() * Col.GetTypeSize()); };
+
+            PutCol(EGraphStoreSection::StrOffsets, StrOffsets);
+            PutCol(EGraphStoreSection::StrBlob, StrBlob);
+            PutCol(EGraphStoreSection::BlueprintPath, BlueprintPath);
+            PutCol(EGraphStoreSection::NodeBlueprint, NodeBlueprint);
+            PutCol(EGraphStoreSection::NodeGraph, NodeGraph);
+            PutCol(EGraphStoreSection::NodeKind, NodeKind);
+            PutCol(EGraphStoreSection::NodeFunc, NodeFunc);
+            PutCol(EGraphStoreSection::NodeOwner, NodeOwner);
+            PutCol(EGraphStoreSection::NodeVar, NodeVar);
+            PutCol(EGraphStoreSection::NodeTitle, NodeTitle);
+            PutCol(EGraphStoreSection::NodeAnchor, NodeAnchor);
+            PutCol(EGraphStoreSection::PinNode, PinNode);
+            PutCol(EGraphStoreSection::PinName, PinName);
+            PutCol(EGraphStoreSection::PinCategory, PinCategory);
+            PutCol(EGraphStoreSection::PinDefaultObject, PinDefaultObject);
+            PutCol(EGraphStoreSection::PinFlags, PinFlags);
+            PutCol(EGraphStoreSection::EdgeFrom, EdgeFrom);
+            PutCol(EGraphStoreSection::EdgeTo, EdgeTo);
+            PutCol(EGraphStoreSection::FuncIndex, FuncIndex);
+            PutCol(EGraphStoreSection::VarIndex, VarIndex);
+
+            FMemory::Memcpy(Out.GetData(), &H, sizeof(H));
+        }
+
+    private:
+        // 값이 있는(≠ "") 노드 id를 (문자열 순위, 노드) 순으로
+        static TArray<uint32> MakeIndex(const TArray<uint32>& Col)
+        {
+            TArray<uint32> Index;
+            for (int32 N = 0; N < Col.Num(); ++N)
+                if (Col[N] != 0) Index.Add(N);
+            Index.Sort([&Col](uint32 A, uint32 B) { return Col[A] != Col[B] ? Col[A] < Col[B] : A < B; });
+            return Index;
+        }
+
+        FSortedStringTableWriter Strings;  // 조각의 FStringPool처럼 대소문자 구분
+
+        TArray<uint32> BlueprintPath;
+        TArray<uint32> NodeBlueprint, NodeGraph, NodeFunc, NodeOwner, NodeVar, NodeTitle, NodeAnchor;
+        TArray<uint8>  NodeKind;
+        TArray<uint32> PinNode, PinName, PinCategory, PinDefaultObject;
+        TArray<uint8>  PinFlags;
+        TArray<uint32> EdgeFrom, EdgeTo;
+    };
+
+    // 메모리 매핑된 저장소 (읽기 전용). Open 실패 시 IsValid() == false
+    class FGraphStoreReader
+    {
+    public:
+        bool Open(const FString& Path)
+        {
+            Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+            if (!Handle) return false;
+            const int64 Size = Handle->GetFileSize();
+            if (Size < (int64)sizeof(FGraphStoreHeader)) return false;
+            Region.Reset(Handle->MapRegion(0, Size));
+            if (!Region) return false;
+
+            Base = Region->GetMappedPtr();
+            H = reinterpret_cast<const FGraphStoreHeader*>(Base);
+            if (FMemory::Memcmp(H->Magic, GraphStoreMagic, sizeof(H->Magic)) != 0 || H->Version != GraphStoreVersion) return Fail();
+            for (uint32 S = 0; S < (uint32)EGraphStoreSection::Count; ++S)
+            {
+                if (H->Sizes[S] > (uint64)Size || H->Offsets[S] > (uint64)Size - H->Sizes[S]) return Fail();
+                if (H->Sizes[S] != ExpectedSize((EGraphStoreSection)S)) return Fail();
+            }
+            // 문자열 오프셋: 0부터 단조 증가, 끝은 StrBlob 크기
+            if (!Strings.Init(Col<uint32>(EGraphStoreSection::StrOffsets), H->NumStrings,
+                Base + H->Offsets[(uint32)EGraphStoreSection::StrBlob], H->Sizes[(uint32)EGraphStoreSection::StrBlob])) return Fail();
+            // 쿼리가 따라가는 노드 / BP 참조도 범위 검사 (문자열 id는 Str()이 막음)
+            auto IdsBelow = [this](EGraphStoreSection S, uint32 Num, uint32 Limit)
+                {
+                    const uint32* C = Col<uint32>(S);
+                    for (uint32 i = 0; i < Num; ++i) if (C[i] >= Limit) return false;
+                    return true;
+                };
+            if (!IdsBelow(EGraphStoreSection::FuncIndex, H->NumFuncIndex, H->NumNodes)
+                || !IdsBelow(EGraphStoreSection::VarIndex, H->NumVarIndex, H->NumNodes)
+                || !IdsBelow(EGraphStoreSection::NodeBlueprint, H->NumNodes, H->NumBlueprints)) return Fail();
+            return true;
+        }
+
+        bool IsValid() const { return H != nullptr; }
+        const FGraphStoreHeader& Header() const { return *H; }
+
+        FString Str(uint32 Id) const { return Strings.Str(Id); }
+
+        // 대소문자 무시로 S와 같은 문자열들의 id 구간
+        FStringIdRun FindStrings(const FString& S) const { return Strings.FindStrings(S); }
+
+        // 함수명 / 변수명 id가 Ids 구간 안인 노드들 (인덱스가 id 순이라 한 구간)
+        TConstArrayView<uint32> NodesByFunc(const FStringIdRun& Ids) const { return Range(EGraphStoreSection::FuncIndex, H->NumFuncIndex, EGraphStoreSection::NodeFunc, Ids); }
+        TConstArrayView<uint32> NodesByVar(const FStringIdRun& Ids) const  { return Range(EGraphStoreSection::VarIndex, H->NumVarIndex, EGraphStoreSection::NodeVar, Ids); }
+
+        template <typename T>
+        const T* Col(EGraphStoreSection S) const { return reinterpret_cast<const T*>(Base + H->Offsets[(uint32)S]); }
+
+        uint32 NodeU32(EGraphStoreSection S, uint32 Node) const { return Col<uint32>(S)[Node]; }
+        uint8  NodeKindOf(uint32 Node) const { return Col<uint8>(EGraphStoreSection::NodeKind)[Node]; }
+        FString NodeBlueprintPath(uint32 Node) const
+        {
+            return Str(Col<uint32>(EGraphStoreSection::BlueprintPath)[NodeU32(EGraphStoreSection::NodeBlueprint, Node)]);
+        }
+
+    private:
+        bool Fail() { H = nullptr; Strings = FSortedStringTableView(); return false; }
+
+        // 섹션 크기 = 개수 × 원소 크기 (StrBlob은 오프셋으로 따로 검사)
+        uint64 ExpectedSize(EGraphStoreSection S) const
+        {
+            switch (S)
+            {
+            case EGraphStoreSection::StrOffsets:    return (uint64(H->NumStrings) + 1) * sizeof(uint32);
+            case EGraphStoreSection::StrBlob:       return H->Sizes[(uint32)S];
+            case EGraphStoreSection::BlueprintPath: return uint64(H->NumBlueprints) * sizeof(uint32);
+            case EGraphStoreSection::NodeKind:      return uint64(H->NumNodes) * sizeof(uint8);
+            case EGraphStoreSection::NodeBlueprint:
+            case EGraphStoreSection::NodeGraph:
+            case EGraphStoreSection::NodeFunc:
+            case EGraphStoreSection::NodeOwner:
+            case EGraphStoreSection::NodeVar:
+            case EGraphStoreSection::NodeTitle:
+            case EGraphStoreSection::NodeAnchor:    return uint64(H->NumNodes) * sizeof(uint32);
+            case EGraphStoreSection::PinFlags:      return uint64(H->NumPins) * sizeof(uint8);
+            case EGraphStoreSection::PinNode:
+            case EGraphStoreSection::PinName:
+            case EGraphStoreSection::PinCategory:
+            case EGraphStoreSection::PinDefaultObject: return uint64(H->NumPins) * sizeof(uint32);
+            case EGraphStoreSection::EdgeFrom:
+            case EGraphStoreSection::EdgeTo:        return uint64(H->NumEdges) * sizeof(uint32);
+            case EGraphStoreSection::FuncIndex:     return uint64(H->NumFuncIndex) * sizeof(uint32);
+            case EGraphStoreSection::VarIndex:      return uint64(H->NumVarIndex) * sizeof(uint32);
+            default:                                return 0;
+            }
+        }
+
+        TConstArrayView<uint32> Range(EGraphStoreSection IndexSec, uint32 Num, EGraphStoreSection KeySec, const FStringIdRun& Ids) const
+        {
+            if (Ids.IsEmpty() || Ids.End() <= 1) return TConstArrayView<uint32>(); // id 0 ("")은 인덱스에 없음
+            const TConstArrayView<uint32> Index(Col<uint32>(IndexSec), (int32)Num);
+            const uint32* Key = Col<uint32>(KeySec);
+            auto Proj = [Key](uint32 N) { return Key[N]; };
+            const int32 Lo = Algo::LowerBoundBy(Index, (uint32)FMath::Max(Ids.First, 1), Proj);
+            const int32 Hi = Algo::LowerBoundBy(Index, (uint32)Ids.End(), Proj);
+            return Index.Slice(Lo, Hi - Lo);
+        }
+
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+        const uint8* Base = nullptr;
+        const FGraphStoreHeader* H = nullptr;
+        FSortedStringTableView Strings;
+    };
+}
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "Misc/SecureHash.h"
 #include "Misc/FileHelper.h"
+#include "BTD_Utf8.h"
 
 namespace BTD
 {
@@ -14,46 +15,64 @@ namespace BTD
     }
 
     // UE5.6 FSHA256 . Ȥ ٸ FSHA1 ü(ξ "sha1:")
-    inline FString BytesSHA256(const TArray<uint8>& Bytes)
+    inline FString BytesSHA256(const uint8* Data, int64 Len)
     {
 #if defined(FSHA256_DIGESTSIZE) || defined(UE_VERSION_5_2_OR_LATER)
         uint8 Digest[32];
-        FSHA256::HashBuffer(Bytes.GetData(), Bytes.Num(), Digest);
+        FSHA256::HashBuffer(Data, Len, Digest);
         return HexLower(Digest, 32);
 #else
         uint8 Digest[20];
-        FSHA1::HashBuffer(Bytes.GetData(), Bytes.Num(), Digest);
+        FSHA1::HashBuffer(Data, Len, Digest);
         return FString(TEXT("sha1:")) + HexLower(Digest, 20);
 #endif
     }
 
-    inline FString FileSHA256(const FString& Path)
+    inline FString BytesSHA256(const TArray<uint8>& Bytes)
     {
-        TArray<uint8> Buf;
-        if (!FFileHelper::LoadFileToArray(Buf, *Path)) return TEXT("");
-        return BytesSHA256(Buf);
+        return BytesSHA256(Bytes.GetData(), Bytes.Num());
     }
 
-    //    ̾ Ʈ ؽ
-    inline FString MultiFileSHA256(const TArray<FString>& Paths)
+    // Per-Blueprint hash ledger. Each artifact is hashed once from its in-memory bytes
+    // when it is handed to the writer, so nothing is read back from disk just to hash it.
+    struct FHashLedger
     {
-        FString Combined;
-        Combined.Reserve(Paths.Num() * 80);
-       for (const FString& P : Paths)
-             {
-            TArray<uint8> Buf;
-            if (FFileHelper::LoadFileToArray(Buf, *P))
-                 {
-                const FString One = BytesSHA256(Buf);
-                Combined += One;
-                Combined += TEXT("|");
-                Combined += P;
-                Combined += TEXT(";");
-                }
-             }
-         FTCHARToUTF8 Conv(*Combined);
-        TArray<uint8> AsBytes;
-        AsBytes.Append(reinterpret_cast<const uint8*>(Conv.Get()), Conv.Length());
-        return BytesSHA256(AsBytes);
-    }
+        TArray<TPair<FString, FString>> Entries; // path  hash,  
+
+        void Record(const FString& Path, const uint8* Data, int64 Len)
+        {
+            const FString Hash = BytesSHA256(Data, Len);
+            for (TPair<FString, FString>& E : Entries)
+            {
+                if (E.Key == Path) { E.Value = Hash; return; }
+            }
+            Entries.Emplace(Path, Hash);
+        }
+
+        //   ڿ
+        FString Get(const FString& Path) const
+        {
+            for (const TPair<FString, FString>& E : Entries)
+            {
+                if (E.Key == Path) return E.Value;
+            }
+            return FString();
+        }
+
+        // bpflow  ؽ: "<sha>|<path>;"  ؽ ( MultiFileSHA256  )
+        FString Combined(const TArray<FString>& Paths) const
+        {
+            FScopedUtf8Builder Buf;
+            for (const FString& P : Paths)
+            {
+                const FString Hash = Get(P);
+                if (Hash.IsEmpty()) continue;
+                *Buf += Hash;
+                *Buf += TEXT("|");
+                *Buf += P;
+                *Buf += TEXT(";");
+            }
+            return BytesSHA256(Buf->GetData(), Buf->Num());
+        }
+    };
 }
@@ -0,0 +1,202 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "BTD_GraphIR.h"
+
+// Lint rule framework (bplint.md).
+// Each rule declares which nodes it cares about (node kinds, node flags, function classes or names) and
+// whether it wants to see their input pins. The dispatcher walks every graph once, resolves the
+// interested rules per node (function-name matches are cached per interned function id) and
+// scans input pins once for all pin rules. Graphs are linted in parallel into separate evidence
+// objects that are appended in graph order, so reports do not depend on scheduling.
+namespace BTD
+{
+    struct FLintInterest
+    {
+        uint32 KindMask = 0;                // 1 << ENodeKind
+        uint16 FlagMask = 0;                // ENodeFlags, any
+        uint32 FuncClassMask = 0;           // CallFunction: EFunctionClass 중 하나라도
+        TArray<FString> FuncPrefixes;       // CallFunction: 이름이 이 중 하나로 시작하거나
+        TArray<FString> FuncSubstrings;     //               이 중 하나를 포함
+        bool bInputPins = false;            // 관심 노드의 입력 핀마다 VisitInputPin
+
+        FLintInterest& Kind(ENodeKind K)             { KindMask |= 1u << uint32(K); return *this; }
+        FLintInterest& AllKinds()                    { KindMask = ~0u; return *this; }
+        FLintInterest& Flag(uint16 F)                { FlagMask |= F; return *this; }
+        FLintInterest& FuncClass(uint32 Mask)        { Kind(ENodeKind::CallFunction); FuncClassMask |= Mask; return *this; }
+        FLintInterest& FuncStartsWith(const TCHAR* S) { Kind(ENodeKind::CallFunction); FuncPrefixes.Add(S); return *this; }
+        FLintInterest& FuncContains(const TCHAR* S)  { Kind(ENodeKind::CallFunction); FuncSubstrings.Add(S); return *this; }
+        FLintInterest& InputPins()                   { bInputPins = true; return *this; }
+
+        bool HasFuncFilter() const { return FuncClassMask != 0 || FuncPrefixes.Num() > 0 || FuncSubstrings.Num() > 0; }
+        bool MatchesFunc(const FString& Fn, uint32 FnClass) const
+        {
+            if (FnClass & FuncClassMask) return true;
+            for (const FString& P : FuncPrefixes)   if (Fn.StartsWith(P)) return true;
+            for (const FString& S : FuncSubstrings) if (Fn.Contains(S)) return true;
+            return false;
+        }
+    };
+
+    // EvidenceT: 규칙들이 채우는 결과. Append(EvidenceT&&)로 그래프별 결과를 합침
+    template <typename EvidenceT>
+    class TLintRule
+    {
+    public:
+        virtual ~TLintRule() = default;
+        virtual const TCHAR* GetName() const = 0;
+        virtual void Declare(FLintInterest& Interest) const = 0;
+        virtual void VisitNode(const FGraphIR& G, int32 Node, const FString& Anchor, EvidenceT& Out) const {}
+        virtual void VisitInputPin(const FGraphIR& G, int32 Node, int32 Pin, const FString& Anchor, EvidenceT& Out) const {}
+    };
+
+    template <typename EvidenceT>
+    class TLintDispatcher
+    {
+    public:
+        using FRule = TLintRule<EvidenceT>;
+
+        // 등록은 Run() 전에 (보통 정적 초기화 1회)
+        void Register(TUniquePtr<FRule> Rule)
+        {
+            const int32 Id = Rules.Num();
+            FLintInterest& I = Interests.AddDefaulted_GetRef();
+            Rule->Declare(I);
+            Rules.Add(MoveTemp(Rule));
+            Cycles.Add(0);
+            Calls.Add(0);
+
+            for (uint32 K = 0; K < 32; ++K)
+            {
+                if (!(I.KindMask & (1u << K))) continue;
+                if (K == uint32(ENodeKind::CallFunction) && I.HasFuncFilter()) FuncRules.Add(Id);
+                else ByKind[K].Add(Id);
+            }
+            if (I.FlagMask) FlagRules.Add(Id);
+        }
+
+        int32 Num() const { return Rules.Num(); }
+
+        void Run(const TArray<FGraphIR>& Graphs, EvidenceT& Out) const
+        {
+            const int32 NumGraphs = Graphs.Num();
+            TArray<EvidenceT> PerGraph;
+            PerGraph.SetNum(NumGraphs);
+            TArray<TArray<uint64>> PerGraphCycles, PerGraphCalls;
+            PerGraphCycles.SetNum(NumGraphs);
+            PerGraphCalls.SetNum(NumGraphs);
+
+            int32 TotalNodes = 0;
+            for (const FGraphIR& G : Graphs) TotalNodes += G.NumNodes();
+            const bool bSingleThread = NumGraphs < 2 || TotalNodes < ParallelMinNodes;
+
+            ParallelFor(NumGraphs, [&](int32 Gi)
+                {
+                    RunGraph(Graphs[Gi], PerGraph[Gi], PerGraphCycles[Gi], PerGraphCalls[Gi]);
+                }, bSingleThread);
+
+            for (EvidenceT& E : PerGraph) Out.Append(MoveTemp(E));
+
+            FScopeLock Lock(&StatsLock);
+            for (int32 Gi = 0; Gi < NumGraphs; ++Gi)
+            {
+                for (int32 R = 0; R < Rules.Num(); ++R)
+                {
+                    Cycles[R] += PerGraphCycles[Gi][R];
+                    Calls[R] += PerGraphCalls[Gi][R];
+                }
+            }
+        }
+
+        void ResetStats() const
+        {
+            FScopeLock Lock(&StatsLock);
+            for (int32 R = 0; R < Rules.Num(); ++R) { Cycles[R] = 0; Calls[R] = 0; }
+        }
+
+        void LogStats(const TCHAR* Label) const
+        {
+            FScopeLock Lock(&StatsLock);
+            for (int32 R = 0; R < Rules.Num(); ++R)
+            {
+                if (Calls[R] == 0) continue;
+                UE_LOG(LogTemp, Display, TEXT("%s: lint %-24s %10llu calls %8.2f ms"),
+                    Label, Rules[R]->GetName(), Calls[R], FPlatformTime::ToMilliseconds64(Cycles[R]));
+            }
+        }
+
+    private:
+        static constexpr int32 ParallelMinNodes = 2000; // 이보다 작은 BP는 그래프 병렬화 이득이 없음
+
+        void RunGraph(const FGraphIR& G, EvidenceT& Out, TArray<uint64>& RuleCycles, TArray<uint64>& RuleCalls) const
+        {
+            RuleCycles.Init(0, Rules.Num());
+            RuleCalls.Init(0, Rules.Num());
+
+            TMap<int32, TArray<int32, TInlineAllocator<4>>> FuncCache; // 함수명 id → 맞는 FuncRules
+            TArray<int32, TInlineAllocator<8>> Active;
+            TArray<int32, TInlineAllocator<8>> PinRules;
+
+            for (const int32 N : G.Sorted)
+            {
+                const uint32 K = uint32(G.NodeKind[N]);
+                Active.Reset();
+                Active.Append(ByKind[K]);
+                if (G.NodeKind[N] == ENodeKind::CallFunction && FuncRules.Num() > 0)
+                {
+                    const int32 FnId = G.NodeFunc[N];
+                    TArray<int32, TInlineAllocator<4>>* Matched = FuncCache.Find(FnId); // 분류도 함수 단위라 같은 id면 같은 결과
+                    if (!Matched)
+                    {
+                        Matched = &FuncCache.Add(FnId);
+                        const FString& Fn = G.Str(FnId);
+                        for (const int32 R : FuncRules)
+                            if (Interests[R].MatchesFunc(Fn, G.NodeFuncClass[N])) Matched->Add(R);
+                    }
+                    for (const int32 R : *Matched) Active.AddUnique(R);
+                }
+                for (const int32 R : FlagRules)
+                {
+                    if (G.HasFlag(N, Interests[R].FlagMask)) Active.AddUnique(R);
+                }
+                if (Active.Num() == 0) continue;
+
+                const FString& A = G.AnchorKey(N);
+                PinRules.Reset();
+                for (const int32 R : Active)
+                {
+                    const uint64 T0 = FPlatformTime::Cycles64();
+                    Rules[R]->VisitNode(G, N, A, Out);
+                    RuleCycles[R] += FPlatformTime::Cycles64() - T0;
+                    ++RuleCalls[R];
+                    if (Interests[R].bInputPins) PinRules.Add(R);
+                }
+                if (PinRules.Num() == 0) continue;
+
+                // 입력 핀은 한 번만 훑고 핀 규칙 전부에 전달
+                for (int32 P = G.NodeFirstPin[N], E = P + G.NodeNumPins[N]; P < E; ++P)
+                {
+                    if (!G.IsInput(P)) continue;
+                    for (const int32 R : PinRules)
+                    {
+                        const uint64 T0 = FPlatformTime::Cycles64();
+                        Rules[R]->VisitInputPin(G, N, P, A, Out);
+                        RuleCycles[R] += FPlatformTime::Cycles64() - T0;
+                    }
+                }
+            }
+        }
+
+        TArray<TUniquePtr<FRule>> Rules;
+        TArray<FLintInterest> Interests;
+        TArray<int32> ByKind[32];   // 함수명 조건 없는 규칙 (노드 종류별)
+        TArray<int32> FuncRules;    // CallFunction + 함수명 조건
+        TArray<int32> FlagRules;
+
+        mutable FCriticalSection StatsLock;
+        mutable TArray<uint64> Cycles, Calls;
+    };
+}
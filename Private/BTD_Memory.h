@@ -0,0 +1,115 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+namespace BTD
+{
+    // MemBudgetMB= for bulk dumps (game thread only).
+    // Tick() is called once per processed asset and samples resident memory. Past the budget,
+    // every package loaded since construction that is not dirty loses RF_Standalone and a GC runs,
+    // so Blueprints (and their dependencies) loaded by this command do not stay resident.
+    // Packages that were already in memory and packages with unsaved edits are left alone, as are
+    // the packages named by the keep-alive callback (e.g. the prefetch window that is still ahead).
+    class FMemoryBudget
+    {
+    public:
+        FMemoryBudget(int32 InBudgetMB, const TCHAR* InLabel)
+            : BudgetBytes(uint64(FMath::Max(0, InBudgetMB)) * 1024 * 1024)
+            , Threshold(BudgetBytes)
+            , Label(InLabel)
+        {
+            if (!IsEnabled()) return;
+            for (TObjectIterator<UPackage> It; It; ++It) Baseline.Add(It->GetFName());
+            BatchPeak = FPlatformMemory::GetStats().UsedPhysical;
+        }
+
+        bool IsEnabled() const { return BudgetBytes > 0; }
+
+        // GC 때마다 호출: 아직 쓸 패키지 이름을 채움 (선택)
+        void SetKeepAlive(TFunction<void(TSet<FName>&)> InKeepAlive) { KeepAlive = MoveTemp(InKeepAlive); }
+
+        // 자산 하나 처리 후 호출. 예산을 넘어 GC를 돌렸으면 true
+        bool Tick()
+        {
+            if (!IsEnabled()) return false;
+            ++BatchAssets;
+            const uint64 Used = FPlatformMemory::GetStats().UsedPhysical;
+            BatchPeak = FMath::Max(BatchPeak, Used);
+            if (Used < Threshold) return false;
+            Collect();
+            return true;
+        }
+
+        // 마지막 배치와 전체 요약 출력
+        void Log() const
+        {
+            if (!IsEnabled()) return;
+            if (BatchAssets > 0)
+                UE_LOG(LogTemp, Display, TEXT("%s: memory batch %d: %d assets, peak %.0f MB (no GC)"),
+                    Label, Batches + 1, BatchAssets, ToMB(BatchPeak));
+            UE_LOG(LogTemp, Display, TEXT("%s: memory budget %.0f MB, %d GCs (%.2fs), %d packages released, overall peak %.0f MB"),
+                Label, ToMB(BudgetBytes), Batches, GCSeconds, Released, ToMB(FMath::Max(OverallPeak, BatchPeak)));
+        }
+
+    private:
+        static double ToMB(uint64 Bytes) { return double(Bytes) / (1024.0 * 1024.0); }
+
+        void Collect()
+        {
+            const double T0 = FPlatformTime::Seconds();
+            int32 NumReleased = 0;
+            TSet<FName> Keep;
+            if (KeepAlive) KeepAlive(Keep);
+            for (TObjectIterator<UPackage> It; It; ++It)
+            {
+                UPackage* Pkg = *It;
+                if (Pkg == GetTransientPackage() || Pkg->IsDirty() || Pkg->HasAnyFlags(RF_RootSet)) continue;
+                if (Baseline.Contains(Pkg->GetFName()) || Keep.Contains(Pkg->GetFName())) continue;
+                ForEachObjectWithPackage(Pkg, [](UObject* Obj)
+                    {
+                        Obj->ClearFlags(RF_Standalone);
+                        return true;
+                    }, false);
+                ++NumReleased;
+            }
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+            const uint64 After = FPlatformMemory::GetStats().UsedPhysical;
+            const double Secs = FPlatformTime::Seconds() - T0;
+            ++Batches;
+            GCSeconds += Secs;
+            Released += NumReleased;
+            OverallPeak = FMath::Max(OverallPeak, BatchPeak);
+            UE_LOG(LogTemp, Display, TEXT("%s: memory batch %d: %d assets, peak %.0f MB, released %d packages, %.0f MB after GC (%.2fs)"),
+                Label, Batches, BatchAssets, ToMB(BatchPeak), NumReleased, ToMB(After), Secs);
+
+            // GC 후에도 예산 위면 매 자산마다 GC하지 않도록 다음 기준을 올림
+            Threshold = FMath::Max(BudgetBytes, After + BudgetBytes / 10);
+            if (Threshold > BudgetBytes)
+                UE_LOG(LogTemp, Warning, TEXT("%s: still %.0f MB after GC (budget %.0f MB), next GC at %.0f MB"),
+                    Label, ToMB(After), ToMB(BudgetBytes), ToMB(Threshold));
+
+            BatchAssets = 0;
+            BatchPeak = After;
+        }
+
+        uint64 BudgetBytes = 0;
+        uint64 Threshold = 0;
+        const TCHAR* Label = TEXT("");
+        TSet<FName> Baseline; // 명령 시작 시 이미 로드돼 있던 패키지
+        TFunction<void(TSet<FName>&)> KeepAlive;
+
+        int32 BatchAssets = 0;
+        uint64 BatchPeak = 0;
+        uint64 OverallPeak = 0;
+        int32 Batches = 0;
+        int32 Released = 0;
+        double GCSeconds = 0.0;
+    };
+}
@@ -0,0 +1,193 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "BTD_Output.h"
+
+// Streaming NDJSON reading for artifacts such as <BP>.bpfacts.ndjson.
+// Files are read in fixed-size chunks and every line is handed out as a view into the chunk
+// buffer (no FString per line, no whole-file copy). Queued artifacts that have not reached
+// disk yet are read from the writer's pending buffer instead.
+namespace BTD
+{
+    static constexpr int32 NDJsonChunkBytes = 64 * 1024;
+
+    inline FString ToFString(FUtf8StringView View)
+    {
+        FUTF8ToTCHAR Conv(reinterpret_cast<const ANSICHAR*>(View.GetData()), View.Len());
+        return FString(Conv.Length(), Conv.Get());
+    }
+
+    namespace NDJsonPrivate
+    {
+        // 줄 끝 '\r' 제거, 공백뿐인 줄은 건너뜀
+        template <typename FnType>
+        void EmitLine(const UTF8CHAR* Begin, const UTF8CHAR* End, FnType& Fn)
+        {
+            if (End > Begin && End[-1] == '\r') --End;
+            const UTF8CHAR* P = Begin;
+            while (P < End && (*P == ' ' || *P == '\t')) ++P;
+            if (P == End) return;
+            Fn(FUtf8StringView(Begin, int32(End - Begin)));
+        }
+
+        // Data 안의 완결된 줄을 모두 내보내고 처리한 바이트 수를 돌려줌
+        template <typename FnType>
+        int32 EmitLines(const uint8* Data, int32 Num, bool bFinal, FnType& Fn)
+        {
+            const UTF8CHAR* Begin = reinterpret_cast<const UTF8CHAR*>(Data);
+            const UTF8CHAR* End = Begin + Num;
+            const UTF8CHAR* LineStart = Begin;
+            for (const UTF8CHAR* P = Begin; P < End; ++P)
+            {
+                if (*P != '\n') continue;
+                EmitLine(LineStart, P, Fn);
+                LineStart = P + 1;
+            }
+            if (bFinal && LineStart < End)
+            {
+                EmitLine(LineStart, End, Fn);
+                LineStart = End;
+            }
+            return int32(LineStart - Begin);
+        }
+
+        inline int32 BomLength(const uint8* Data, int32 Num)
+        {
+            return (Num >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF) ? 3 : 0;
+        }
+    }
+
+    // Fn(FUtf8StringView Line): 뷰는 호출 동안만 유효. 파일이 없으면 false
+    template <typename FnType>
+    bool ForEachNDJsonLine(const FString& Path, FnType Fn)
+    {
+        TArray<uint8> Buffer;
+
+        // 아직 기록 대기 중인 산출물은 큐의 버퍼를 그대로 사용
+        if (const FArtifactWriter* W = ArtifactWriterSlot().Get())
+        {
+            if (W->FindPending(Path, Buffer))
+            {
+                const int32 Bom = NDJsonPrivate::BomLength(Buffer.GetData(), Buffer.Num());
+                NDJsonPrivate::EmitLines(Buffer.GetData() + Bom, Buffer.Num() - Bom, true, Fn);
+                return true;
+            }
+        }
+
+        TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path));
+        if (!File) return false;
+
+        int64 Remaining = File->Size();
+        int32 Used = 0;       // Buffer 앞쪽의 아직 처리하지 않은 바이트 (이전 청크의 잘린 줄)
+        bool bFirst = true;
+        Buffer.SetNumUninitialized(NDJsonChunkBytes);
+        while (Remaining > 0)
+        {
+            // 한 줄이 버퍼보다 길면 버퍼를 키움
+            if (Buffer.Num() - Used < NDJsonChunkBytes / 2) Buffer.SetNumUninitialized(Buffer.Num() * 2);
+            const int32 ToRead = int32(FMath::Min<int64>(Remaining, Buffer.Num() - Used));
+            if (!File->Read(Buffer.GetData() + Used, ToRead)) return false;
+            Remaining -= ToRead;
+            Used += ToRead;
+
+            int32 Start = 0;
+            if (bFirst) { Start = NDJsonPrivate::BomLength(Buffer.GetData(), Used); bFirst = false; }
+            const int32 Consumed = Start + NDJsonPrivate::EmitLines(Buffer.GetData() + Start, Used - Start, Remaining == 0, Fn);
+            if (Consumed < Used) FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + Consumed, Used - Consumed);
+            Used -= Consumed;
+        }
+        return true;
+    }
+
+    // bpfacts.ndjson 한 줄의 s / p / o와 첫 근거 앵커. 뷰는 콜백 동안만 유효
+    struct FFactView
+    {
+        FUtf8StringView S, P, O, Ev;
+    };
+
+    // WriteFactLine이 쓰는 모양 그대로인 줄만 처리: {"s":"..","p":"..","o":<string|number>,"ev":[..]}
+    // 이스케이프, 다른 키 순서, 공백 등은 false → 일반 JSON 파서로
+    inline bool ParseFactLineFast(FUtf8StringView Line, FFactView& Out)
+    {
+        const UTF8CHAR* P = Line.GetData();
+        const UTF8CHAR* End = P + Line.Len();
+
+        auto Expect = [&](const char* Lit)
+            {
+                for (; *Lit; ++Lit, ++P)
+                {
+                    if (P == End || *P != UTF8CHAR(*Lit)) return false;
+                }
+                return true;
+            };
+        auto String = [&](FUtf8StringView& V)
+            {
+                if (P == End || *P != '"') return false;
+                const UTF8CHAR* S = ++P;
+                while (P < End && *P != '"')
+                {
+                    if (*P == '\\') return false;
+                    ++P;
+                }
+                if (P == End) return false;
+                V = FUtf8StringView(S, int32(P - S));
+                ++P;
+                return true;
+            };
+        auto Number = [&](FUtf8StringView& V)
+            {
+                const UTF8CHAR* S = P;
+                while (P < End && ((*P >= '0' && *P <= '9') || *P == '-' || *P == '+' || *P == '.' || *P == 'e' || *P == 'E')) ++P;
+                if (P == S) return false;
+                V = FUtf8StringView(S, int32(P - S));
+                return true;
+            };
+
+        if (!Expect("{\"s\":") || !String(Out.S)) return false;
+        if (!Expect(",\"p\":") || !String(Out.P)) return false;
+        if (!Expect(",\"o\":")) return false;
+        if (!(P < End && *P == '"' ? String(Out.O) : Number(Out.O))) return false;
+        if (P < End && *P == '}') return true;
+        if (!Expect(",\"ev\":[")) return false;
+        if (P < End && *P == ']') return true;
+        return String(Out.Ev);
+    }
+
+    // Fn(const FFactView&). 모양이 다른 줄은 FJsonObject로 파싱해서 같은 뷰로 넘김
+    // OutFallbackLines: 일반 파서로 처리한 줄 수 (선택)
+    template <typename FnType>
+    bool ForEachFactLine(const FString& Path, FnType Fn, int32* OutFallbackLines = nullptr)
+    {
+        return ForEachNDJsonLine(Path, [&](FUtf8StringView Line)
+            {
+                FFactView V;
+                if (ParseFactLineFast(Line, V))
+                {
+                    Fn(V);
+                    return;
+                }
+
+                TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(ToFString(Line));
+                TSharedPtr<FJsonObject> O;
+                if (!FJsonSerializer::Deserialize(R, O) || !O.IsValid()) return;
+                if (OutFallbackLines) ++*OutFallbackLines;
+
+                FString S, Pred, Obj, Ev;
+                O->TryGetStringField(TEXT("s"), S);
+                O->TryGetStringField(TEXT("p"), Pred);
+                O->TryGetStringField(TEXT("o"), Obj);
+                const TArray<TSharedPtr<FJsonValue>>* EvArr = nullptr;
+                if (O->TryGetArrayField(TEXT("ev"), EvArr) && EvArr->Num() > 0) (*EvArr)[0]->TryGetString(Ev);
+                const FTCHARToUTF8 S8(*S), P8(*Pred), O8(*Obj), E8(*Ev);
+                V.S = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(S8.Get()), S8.Length());
+                V.P = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(P8.Get()), P8.Length());
+                V.O = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(O8.Get()), O8.Length());
+                V.Ev = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(E8.Get()), E8.Length());
+                Fn(V);
+            });
+    }
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+namespace BTD
+{
+    // Write-if-changed output layer. Identical artifacts are left untouched (mtime kept),
+    // so rsync / file watchers only see real changes. Safe to call from worker threads.
+    struct FOutputStats
+    {
+        std::atomic<int32> Written{ 0 };
+        std::atomic<int32> Skipped{ 0 };
+        std::atomic<int32> Failed{ 0 };
+        std::atomic<int64> BytesWritten{ 0 };
+        std::atomic<int64> BytesTotal{ 0 };    // written + skipped
+
+        // write-behind queue (FArtifactWriter)
+        std::atomic<int32> Queued{ 0 };
+        std::atomic<int32> Batches{ 0 };
+        std::atomic<int32> MaxQueueDepth{ 0 };
+        std::atomic<int32> Stalls{ 0 };        // producer waited for queue space
+        std::atomic<int64> StallMicros{ 0 };
+        std::atomic<int32> Flushes{ 0 };
+        std::atomic<int64> FlushMicros{ 0 };
+        std::atomic<int32> DirsCreated{ 0 };
+
+        void Reset()
+        {
+            Written = 0; Skipped = 0; Failed = 0;
+            BytesWritten = 0; BytesTotal = 0;
+            Queued = 0; Batches = 0; MaxQueueDepth = 0;
+            Stalls = 0; StallMicros = 0; Flushes = 0; FlushMicros = 0; DirsCreated = 0;
+        }
+
+        void Log(const TCHAR* Label) const
+        {
+            UE_LOG(LogTemp, Display, TEXT("%s: output %d written, %d unchanged (skipped), %d failed; %lld of %lld bytes written"),
+                Label, Written.load(), Skipped.load(), Failed.load(), BytesWritten.load(), BytesTotal.load());
+            UE_LOG(LogTemp, Display, TEXT("%s: writer %d queued in %d batches (max depth %d), %d stalls %.3fs, %d flushes %.3fs, %d dirs created"),
+                Label, Queued.load(), Batches.load(), MaxQueueDepth.load(),
+                Stalls.load(), StallMicros.load() / 1e6, Flushes.load(), FlushMicros.load() / 1e6, DirsCreated.load());
+        }
+    };
+
+    inline FOutputStats& OutputStats()
+    {
+        static FOutputStats Stats;
+        return Stats;
+    }
+
+    // Same size → compare against the existing bytes; skip the write when equal.
+    inline bool WriteBytesIfChanged(const uint8* Data, int64 Len, const FString& OutPath)
+    {
+        FOutputStats& Stats = OutputStats();
+        Stats.BytesTotal += Len;
+
+        IFileManager& FM = IFileManager::Get();
+        if (FM.FileSize(*OutPath) == Len)
+        {
+            TArray64<uint8> Existing;
+            if (FFileHelper::LoadFileToArray(Existing, *OutPath, FILEREAD_Silent) &&
+                Existing.Num() == Len && FMemory::Memcmp(Existing.GetData(), Data, Len) == 0)
+            {
+                ++Stats.Skipped;
+                return true;
+            }
+        }
+
+        TUniquePtr<FArchive> Ar(FM.CreateFileWriter(*OutPath, 0));
+        if (!Ar)
+        {
+            ++Stats.Failed;
+            return false;
+        }
+        Ar->Serialize(const_cast<uint8*>(Data), Len);
+        const bool bOk = Ar->Close();
+        if (!bOk)
+        {
+            ++Stats.Failed;
+            return false;
+        }
+        ++Stats.Written;
+        Stats.BytesWritten += Len;
+        return true;
+    }
+
+    // Write-behind I/O: emitters hand finished buffers to Enqueue() and move on; a single
+    // writer thread drains the lock-free MPSC queue in batches, creates each output directory
+    // once (cached until the next Flush) and writes through WriteBytesIfChanged.
+    // Enqueue blocks only while Capacity items are in flight (back-pressure).
+    // Queued-but-unwritten buffers stay readable through FindPending() / LoadArtifact().
+    class FArtifactWriter : public FRunnable
+    {
+    public:
+        using FBytesRef = TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>;
+
+        explicit FArtifactWriter(int32 InCapacity)
+            : Capacity(FMath::Max(1, InCapacity))
+        {
+            WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+            SpaceAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+            Idle = FPlatformProcess::GetSynchEventFromPool(false);
+            Thread = FRunnableThread::Create(this, TEXT("BPTextDumpWriter"), 0, TPri_BelowNormal);
+        }
+
+        virtual ~FArtifactWriter() override
+        {
+            Flush();
+            bStopping = true;
+            WorkAvailable->Trigger();
+            if (Thread) { Thread->WaitForCompletion(); delete Thread; Thread = nullptr; }
+            FItem* Left = nullptr;
+            while (Queue.Dequeue(Left)) delete Left;
+            FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+            FPlatformProcess::ReturnSynchEventToPool(SpaceAvailable);
+            FPlatformProcess::ReturnSynchEventToPool(Idle);
+        }
+
+        void Enqueue(const FString& Path, TArray<uint8>&& Bytes)
+        {
+            FOutputStats& Stats = OutputStats();
+
+            // 자리 확보 (CAS): 가득 차면 생산자가 대기
+            int32 D = Depth.load();
+            bool bStalled = false;
+            const double T0 = FPlatformTime::Seconds();
+            for (;;)
+            {
+                if (D < Capacity)
+                {
+                    if (Depth.compare_exchange_weak(D, D + 1)) break;
+                    continue;
+                }
+                bStalled = true;
+                SpaceAvailable->Wait(2);
+                D = Depth.load();
+            }
+            if (bStalled)
+            {
+                ++Stats.Stalls;
+                Stats.StallMicros += (int64)((FPlatformTime::Seconds() - T0) * 1e6);
+            }
+            int32 Max = Stats.MaxQueueDepth.load();
+            while (D + 1 > Max && !Stats.MaxQueueDepth.compare_exchange_weak(Max, D + 1)) {}
+
+            FItem* Item = new FItem{ Path, MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Bytes)), 0 };
+            {
+                FScopeLock L(&PendingLock);
+                Item->Seq = ++NextSeq;
+                Pending.Add(Path, { Item->Seq, Item->Bytes });
+            }
+            ++Stats.Queued;
+            Queue.Enqueue(Item);
+            WorkAvailable->Trigger();
+        }
+
+        // 아직 디스크에 안 나간 최신 버퍼 (없으면 false)
+        bool FindPending(const FString& Path, TArray<uint8>& Out) const
+        {
+            FScopeLock L(&PendingLock);
+            if (const FPending* P = Pending.Find(Path))
+            {
+                Out = *P->Bytes;
+                return true;
+            }
+            return false;
+        }
+
+        // Blocks until everything queued so far is on disk. Also drops the directory cache.
+        void Flush()
+        {
+            const double T0 = FPlatformTime::Seconds();
+            while (Depth.load() > 0)
+            {
+                WorkAvailable->Trigger();
+                Idle->Wait(5);
+            }
+            bResetDirs = true;
+            FOutputStats& Stats = OutputStats();
+            ++Stats.Flushes;
+            Stats.FlushMicros += (int64)((FPlatformTime::Seconds() - T0) * 1e6);
+        }
+
+        virtual uint32 Run() override
+        {
+            TArray<FItem*> Batch;
+            for (;;)
+            {
+                if (bResetDirs.exchange(false)) KnownDirs.Reset();
+
+                FItem* Item = nullptr;
+                while (Batch.Num() < MaxBatch && Queue.Dequeue(Item)) Batch.Add(Item);
+
+                if (Batch.Num() > 0)
+                {
+                    // 같은 디렉터리끼리 모아서 기록
+                    Batch.StableSort([](const FItem& A, const FItem& B) { return A.Path < B.Path; });
+                    for (FItem* It : Batch) WriteOne(*It);
+                    ++OutputStats().Batches;
+
+                    for (FItem* It : Batch)
+                    {
+                        {
+                            FScopeLock L(&PendingLock);
+                            const FPending* P = Pending.Find(It->Path);
+                            if (P && P->Seq == It->Seq) Pending.Remove(It->Path);
+                        }
+                        delete It;
+                        --Depth;
+                    }
+                    Batch.Reset();
+                    SpaceAvailable->Trigger();
+                    Idle->Trigger();
+                    continue;
+                }
+
+                if (bStopping) break;
+                WorkAvailable->Wait(10);
+            }
+            return 0;
+        }
+
+    private:
+        struct FItem
+        {
+            FString Path;
+            FBytesRef Bytes;
+            uint64 Seq;
+        };
+        struct FPending
+        {
+            uint64 Seq;
+            FBytesRef Bytes;
+        };
+
+        void WriteOne(const FItem& It)
+        {
+            const FString Dir = FPaths::GetPath(It.Path);
+            if (!Dir.IsEmpty() && !KnownDirs.Contains(Dir))
+            {
+                IFileManager::Get().MakeDirectory(*Dir, true);
+                KnownDirs.Add(Dir);
+                ++OutputStats().DirsCreated;
+            }
+            if (!WriteBytesIfChanged(It.Bytes->GetData(), It.Bytes->Num(), It.Path))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Failed to write %s"), *It.Path);
+            }
+        }
+
+        static constexpr int32 MaxBatch = 64;
+
+        TQueue<FItem*, EQueueMode::Mpsc> Queue;
+        std::atomic<int32> Depth{ 0 };     // queued + being written
+        int32 Capacity = 1;
+        std::atomic<bool> bStopping{ false };
+        std::atomic<bool> bResetDirs{ false };
+
+        mutable FCriticalSection PendingLock;
+        TMap<FString, FPending> Pending;   // path → newest queued buffer
+        uint64 NextSeq = 0;
+
+        TSet<FString> KnownDirs;           // writer thread only
+
+        FEvent* WorkAvailable = nullptr;
+        FEvent* SpaceAvailable = nullptr;
+        FEvent* Idle = nullptr;
+        FRunnableThread* Thread = nullptr;
+    };
+
+    inline TUniquePtr<FArtifactWriter>& ArtifactWriterSlot()
+    {
+        static TUniquePtr<FArtifactWriter> Writer;
+        return Writer;
+    }
+
+    // Module startup/shutdown (game thread)
+    inline void StartArtifactWriter(int32 Capacity = 256)
+    {
+        if (!ArtifactWriterSlot()) ArtifactWriterSlot() = MakeUnique<FArtifactWriter>(Capacity);
+    }
+
+    inline void StopArtifactWriter()
+    {
+        ArtifactWriterSlot().Reset(); // flushes
+    }
+
+    inline void FlushArtifacts()
+    {
+        if (FArtifactWriter* W = ArtifactWriterSlot().Get()) W->Flush();
+    }
+
+    // Takes ownership of Bytes. Without a running writer, writes synchronously.
+    inline bool WriteArtifact(const FString& Path, TArray<uint8>&& Bytes)
+    {
+        if (FArtifactWriter* W = ArtifactWriterSlot().Get())
+        {
+            W->Enqueue(Path, MoveTemp(Bytes));
+            return true;
+        }
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        return WriteBytesIfChanged(Bytes.GetData(), Bytes.Num(), Path);
+    }
+
+    // Read an artifact, seeing writes that are still queued.
+    inline bool LoadArtifact(const FString& Path, TArray<uint8>& Out)
+    {
+        if (const FArtifactWriter* W = ArtifactWriterSlot().Get())
+        {
+            if (W->FindPending(Path, Out)) return true;
+        }
+        Out.Reset();
+        return FFileHelper::LoadFileToArray(Out, *Path, FILEREAD_Silent);
+    }
+
+    inline bool LoadArtifactToString(const FString& Path, FString& Out)
+    {
+        TArray<uint8> Bytes;
+        if (!LoadArtifact(Path, Bytes)) return false;
+        FFileHelper::BufferToString(Out, Bytes.GetData(), Bytes.Num());
+        return true;
+    }
+}
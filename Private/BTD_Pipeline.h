@@ -0,0 +1,157 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Function.h"
+
+namespace BTD
+{
+    // Bounded producer/consumer pipeline.
+    // The game thread produces (snapshots) and blocks in Submit() while the queue is full;
+    // N worker threads drain the queue. Work items must not touch UObjects.
+    class FDumpPipeline
+    {
+    public:
+        FDumpPipeline(int32 InJobs, int32 InCapacity)
+            : Capacity(FMath::Max(1, InCapacity))
+        {
+            WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+            SpaceAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+            Idle = FPlatformProcess::GetSynchEventFromPool(false);
+
+            const int32 Jobs = FMath::Max(1, InJobs);
+            for (int32 i = 0; i < Jobs; ++i)
+            {
+                Workers.Add(MakeUnique<FWorker>(*this));
+                Threads.Add(FRunnableThread::Create(Workers.Last().Get(),
+                    *FString::Printf(TEXT("BPTextDumpWorker%d"), i), 0, TPri_BelowNormal));
+            }
+        }
+
+        ~FDumpPipeline()
+        {
+            Drain();
+            {
+                FScopeLock L(&Lock);
+                bStopping = true;
+            }
+            for (FRunnableThread* T : Threads)
+            {
+                WorkAvailable->Trigger();
+                if (T) { T->WaitForCompletion(); delete T; }
+            }
+            Threads.Reset();
+            Workers.Reset();
+            FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+            FPlatformProcess::ReturnSynchEventToPool(SpaceAvailable);
+            FPlatformProcess::ReturnSynchEventToPool(Idle);
+        }
+
+        // Blocks while Capacity items are already queued (back-pressure on the producer).
+        void Submit(TUniqueFunction<void()>&& Work)
+        {
+            const double T0 = FPlatformTime::Seconds();
+            bool bStalled = false;
+            for (;;)
+            {
+                {
+                    FScopeLock L(&Lock);
+                    if (Queue.Num() < Capacity)
+                    {
+                        Queue.Add(MoveTemp(Work));
+                        MaxDepth = FMath::Max(MaxDepth, Queue.Num());
+                        ++Submitted;
+                        break;
+                    }
+                }
+                bStalled = true;
+                SpaceAvailable->Wait(10);
+            }
+            if (bStalled) StallSeconds += FPlatformTime::Seconds() - T0;
+            WorkAvailable->Trigger();
+        }
+
+        // Waits until every submitted item has finished.
+        void Drain()
+        {
+            for (;;)
+            {
+                {
+                    FScopeLock L(&Lock);
+                    if (Queue.Num() == 0 && InFlight == 0) return;
+                }
+                Idle->Wait(10);
+            }
+        }
+
+        int32  GetNumWorkers() const     { return Threads.Num(); }
+        int32  GetMaxDepth() const       { return MaxDepth; }
+        int32  GetSubmitted() const      { return Submitted; }
+        double GetStallSeconds() const   { return StallSeconds; }
+
+    private:
+        class FWorker : public FRunnable
+        {
+        public:
+            explicit FWorker(FDumpPipeline& InOwner) : Owner(InOwner) {}
+            virtual uint32 Run() override
+            {
+                while (Owner.RunOne()) {}
+                return 0;
+            }
+        private:
+            FDumpPipeline& Owner;
+        };
+
+        // Pops and runs one item. Returns false once stopping and nothing is left.
+        bool RunOne()
+        {
+            TUniqueFunction<void()> Work;
+            for (;;)
+            {
+                {
+                    FScopeLock L(&Lock);
+                    if (Queue.Num() > 0)
+                    {
+                        Work = MoveTemp(Queue[0]);
+                        Queue.RemoveAt(0, 1, EAllowShrinking::No);
+                        ++InFlight;
+                        break;
+                    }
+                    if (bStopping) return false;
+                }
+                WorkAvailable->Wait(10);
+            }
+            SpaceAvailable->Trigger();
+
+            Work();
+
+            {
+                FScopeLock L(&Lock);
+                --InFlight;
+            }
+            Idle->Trigger();
+            return true;
+        }
+
+        FCriticalSection Lock;
+        TArray<TUniqueFunction<void()>> Queue; // FIFO, Capacity is small
+        int32 Capacity = 1;
+        int32 InFlight = 0;
+        int32 MaxDepth = 0;
+        int32 Submitted = 0;
+        double StallSeconds = 0.0;
+        bool bStopping = false;
+
+        FEvent* WorkAvailable = nullptr;
+        FEvent* SpaceAvailable = nullptr;
+        FEvent* Idle = nullptr;
+
+        TArray<TUniquePtr<FWorker>> Workers;
+        TArray<FRunnableThread*> Threads;
+    };
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Package.h"
+#include "HAL/PlatformTime.h"
+
+namespace BTD
+{
+    // Sliding-window package prefetch for bulk dumps (game thread only).
+    // Packages are visited in order; while package i is being dumped, LoadPackageAsync is
+    // already in flight for i+1 .. i+Window, so disk/decompression overlaps with extraction.
+    // WaitFor(i) blocks only if package i has not finished loading yet (counted as a stall).
+    class FPackagePrefetcher
+    {
+    public:
+        FPackagePrefetcher(TArray<FName> InPackages, int32 InWindow)
+            : Packages(MoveTemp(InPackages))
+            , Window(FMath::Max(0, InWindow))
+            , State(MakeShared<FState>())
+        {
+            State->Slots.SetNum(Packages.Num());
+        }
+
+        bool IsEnabled() const { return Window > 0; }
+
+        // Index번째 패키지를 쓸 차례: 창을 앞으로 밀고, 로딩 중이면 완료까지 대기
+        void WaitFor(int32 Index)
+        {
+            if (!IsEnabled() || !Packages.IsValidIndex(Index)) return;
+            Current = Index;
+            IssueUpTo(Index + 1 + Window);
+
+            FSlot& S = State->Slots[Index];
+            if (S.bDone)
+            {
+                ++ReadyOnUse;
+                return;
+            }
+            const double T0 = FPlatformTime::Seconds();
+            FlushAsyncLoading(S.RequestId);
+            StallSeconds += FPlatformTime::Seconds() - T0;
+            ++Waited;
+        }
+
+        // 추출 사이사이 비동기 로딩을 조금 진행 (로딩 스레드가 없을 때만 의미 있음)
+        void Pump(double TimeLimitSeconds)
+        {
+            if (!IsEnabled() || IsAsyncLoadingMultithreaded() || !IsAsyncLoading()) return;
+            ProcessAsyncLoading(true, false, TimeLimitSeconds);
+        }
+
+        // 이미 요청했지만 아직 쓰지 않은 패키지 (현재 이후 ~ 창 끝). 메모리 예산 GC에서 제외용
+        void GetPackagesAhead(TSet<FName>& Out) const
+        {
+            for (int32 i = Current + 1; i < Next; ++i) Out.Add(Packages[i]);
+        }
+
+        void Log(const TCHAR* Label) const
+        {
+            if (!IsEnabled()) return;
+            UE_LOG(LogTemp, Display, TEXT("%s: prefetch window %d, %d requested, %d ready on use, %d waited (stalled %.2fs), %d failed"),
+                Label, Window, Issued, ReadyOnUse, Waited, StallSeconds, State->Failed);
+        }
+
+    private:
+        struct FSlot
+        {
+            int32 RequestId = INDEX_NONE;
+            bool bDone = false;
+        };
+        // 완료 콜백이 prefetcher보다 오래 살 수 있으므로 공유 상태로 분리
+        struct FState
+        {
+            TArray<FSlot> Slots;
+            int32 Failed = 0;
+        };
+
+        void IssueUpTo(int32 End)
+        {
+            End = FMath::Min(End, Packages.Num());
+            for (; Next < End; ++Next)
+            {
+                const int32 Idx = Next;
+                TSharedRef<FState> Shared = State;
+                State->Slots[Idx].RequestId = LoadPackageAsync(Packages[Idx].ToString(),
+                    FLoadPackageAsyncDelegate::CreateLambda(
+                        [Shared, Idx](const FName&, UPackage* Loaded, EAsyncLoadingResult::Type Result)
+                        {
+                            Shared->Slots[Idx].bDone = true;
+                            if (Result != EAsyncLoadingResult::Succeeded || !Loaded) ++Shared->Failed;
+                        }));
+                ++Issued;
+            }
+        }
+
+        TArray<FName> Packages;
+        int32 Window = 0;
+        int32 Next = 0;            // 다음에 요청할 인덱스
+        int32 Current = INDEX_NONE; // 마지막 WaitFor 인덱스
+        TSharedRef<FState> State;
+
+        int32 Issued = 0;
+        int32 ReadyOnUse = 0;
+        int32 Waited = 0;
+        double StallSeconds = 0.0;
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "CoreMinimal.h"
+
+namespace BTD
+{
+    // Project reference graph over interned asset keys (BP.ProjectRefs / BP.MergeShards).
+    // Keys get dense int32 ids (case-insensitive, like the FString TMap/TSet it replaces).
+    // Edges are collected as packed (from, to) pairs and compressed once by Build() into
+    // CSR rows for both directions. Rows are ordered by key (FString operator<), so they can
+    // be written out as-is without copying or sorting strings per asset.
+    class FRefGraph
+    {
+    public:
+        int32 Intern(const FString& Key)
+        {
+            if (const int32* Found = Ids.Find(Key)) return *Found;
+            const int32 Id = Keys.Add(Key);
+            Ids.Add(Key, Id);
+            return Id;
+        }
+
+        int32 Find(const FString& Key) const
+        {
+            const int32* Found = Ids.Find(Key);
+            return Found ? *Found : INDEX_NONE;
+        }
+
+        int32 Num() const                  { return Keys.Num(); }
+        const FString& Key(int32 Id) const { return Keys[Id]; }
+
+        // 자기 참조/무효 id는 무시, 중복은 Build()에서 제거
+        void AddEdge(int32 From, int32 To)
+        {
+            if (From == To || From == INDEX_NONE || To == INDEX_NONE) return;
+            Pending.Add((uint64(uint32(From)) << 32) | uint32(To));
+        }
+
+        void Build()
+        {
+            const int32 N = Keys.Num();
+
+            // 키 정렬 순위 = 행 안의 출력 순서
+            TArray<int32> Order;
+            Order.SetNumUninitialized(N);
+            for (int32 i = 0; i < N; ++i) Order[i] = i;
+            Order.Sort([this](int32 A, int32 B) { return Keys[A] < Keys[B]; });
+            TArray<int32> Rank;
+            Rank.SetNumUninitialized(N);
+            for (int32 R = 0; R < N; ++R) Rank[Order[R]] = R;
+
+            // 정방향 (From, Rank(To)), 역방향 (To, Rank(From))
+            TArray<uint64> Fwd, Rev;
+            Fwd.Reserve(Pending.Num());
+            Rev.Reserve(Pending.Num());
+            for (const uint64 E : Pending)
+            {
+                const int32 From = int32(E >> 32);
+                const int32 To = int32(E & 0xFFFFFFFFull);
+                Fwd.Add((uint64(uint32(From)) << 32) | uint32(Rank[To]));
+                Rev.Add((uint64(uint32(To)) << 32) | uint32(Rank[From]));
+            }
+            Pending.Empty();
+
+            MakeRows(Fwd, Order, N, FwdOffsets, FwdTargets);
+            MakeRows(Rev, Order, N, RevOffsets, RevTargets);
+        }
+
+        int32 NumEdges() const { return FwdTargets.Num(); }
+
+        // Build() 이후: Id가 참조하는 키들 / Id를 참조하는 키들 (키 순서)
+        TConstArrayView<int32> Out(int32 Id) const { return Row(FwdOffsets, FwdTargets, Id); }
+        TConstArrayView<int32> In(int32 Id) const  { return Row(RevOffsets, RevTargets, Id); }
+
+    private:
+        static void MakeRows(TArray<uint64>& Edges, const TArray<int32>& Order, int32 N,
+            TArray<int32>& Offsets, TArray<int32>& Targets)
+        {
+            Edges.Sort();
+            Offsets.Init(0, N + 1);
+            Targets.Reset(Edges.Num());
+            uint64 Prev = ~0ull;
+            for (const uint64 E : Edges)
+            {
+                if (E == Prev) continue;
+                Prev = E;
+                ++Offsets[int32(E >> 32) + 1];
+                Targets.Add(Order[int32(E & 0xFFFFFFFFull)]);
+            }
+            for (int32 i = 0; i < N; ++i) Offsets[i + 1] += Offsets[i];
+        }
+
+        static TConstArrayView<int32> Row(const TArray<int32>& Offsets, const TArray<int32>& Targets, int32 Id)
+        {
+            if (Id < 0 || Id + 1 >= Offsets.Num()) return TConstArrayView<int32>();
+            return TConstArrayView<int32>(Targets.GetData() + Offsets[Id], Offsets[Id + 1] - Offsets[Id]);
+        }
+
+        TArray<FString> Keys;
+        TMap<FString, int32> Ids;
+        TArray<uint64> Pending;
+
+        TArray<int32> FwdOffsets, FwdTargets;
+        TArray<int32> RevOffsets, RevTargets;
+    };
+}
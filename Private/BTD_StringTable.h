@@ -0,0 +1,119 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "BTD_GraphIR.h"
+
+// Sorted string table shared by the project stores (project_graph.btdstore, project_facts.btdfacts).
+//
+// On disk it is two sections: uint32[Num + 1] byte offsets and a UTF-8 blob. Strings are sorted
+// case-insensitively, then case-sensitively, with id 0 = "". Strings that differ only in case get
+// consecutive ids, so a case-insensitive lookup is one id run found with two binary searches.
+namespace BTD
+{
+    // 대소문자 구분으로 모아서 Finish에서 정렬 (임시 id → 정렬 순위)
+    class FSortedStringTableWriter
+    {
+    public:
+        FSortedStringTableWriter()
+        {
+            Strings.Add(FString());
+            Ids.Add(FString(), 0);
+        }
+
+        // 임시 id (Finish의 OutRank로 최종 id로 바꿈)
+        uint32 Intern(const FString& S)
+        {
+            if (const int32* Found = Ids.Find(S)) return *Found;
+            const int32 Id = Strings.Add(S);
+            Ids.Add(S, Id);
+            return Id;
+        }
+
+        int32 Num() const { return Strings.Num(); }
+
+        // OutRank[임시 id] = 최종 id. "" 는 항상 0
+        void Finish(TArray<uint32>& OutRank, TArray<uint32>& OutOffsets, TArray<uint8>& OutBlob) const
+        {
+            const int32 NS = Strings.Num();
+            TArray<int32> Order;
+            Order.SetNumUninitialized(NS);
+            for (int32 i = 0; i < NS; ++i) Order[i] = i;
+            Order.Sort([this](int32 A, int32 B)
+                {
+                    const int32 C = Strings[A].Compare(Strings[B], ESearchCase::IgnoreCase);
+                    return C != 0 ? C < 0 : Strings[A].Compare(Strings[B], ESearchCase::CaseSensitive) < 0;
+                });
+            OutRank.SetNumUninitialized(NS);
+            for (int32 R = 0; R < NS; ++R) OutRank[Order[R]] = R;
+
+            OutOffsets.Reset(NS + 1);
+            OutBlob.Reset();
+            for (const int32 Id : Order)
+            {
+                OutOffsets.Add(OutBlob.Num());
+                FTCHARToUTF8 Utf8(*Strings[Id], Strings[Id].Len());
+                OutBlob.Append((const uint8*)Utf8.Get(), Utf8.Length());
+            }
+            OutOffsets.Add(OutBlob.Num());
+        }
+
+    private:
+        TArray<FString> Strings;       // 임시 id 순 (0 = "")
+        TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> Ids; // 대소문자만 다른 문자열도 따로
+    };
+
+    // 매핑된 파일 안의 두 섹션을 가리키는 뷰 (읽기 전용)
+    class FSortedStringTableView
+    {
+    public:
+        // 섹션 크기는 호출 측이 검사 (Offsets = Num + 1개). 오프셋이 0부터 단조 증가하고 끝이 BlobSize여야 true
+        bool Init(const uint32* InOffsets, uint32 InNum, const uint8* InBlob, uint64 InBlobSize)
+        {
+            Offsets = nullptr;
+            NumStrings = 0;
+            if (InOffsets[0] != 0 || InOffsets[InNum] != InBlobSize) return false;
+            for (uint32 i = 0; i < InNum; ++i)
+            {
+                if (InOffsets[i] > InOffsets[i + 1]) return false;
+            }
+            Offsets = InOffsets;
+            Blob = reinterpret_cast<const ANSICHAR*>(InBlob);
+            NumStrings = InNum;
+            return true;
+        }
+
+        uint32 Num() const { return NumStrings; }
+
+        FString Str(uint32 Id) const
+        {
+            if (Id >= NumStrings) return FString();
+            FUTF8ToTCHAR Conv(Blob + Offsets[Id], Offsets[Id + 1] - Offsets[Id]);
+            return FString(Conv.Length(), Conv.Get());
+        }
+
+        // 대소문자 무시로 S와 같은 문자열들의 id 구간 (이진 탐색 두 번)
+        FStringIdRun FindStrings(const FString& S) const
+        {
+            auto Bound = [&](bool bUpper)
+                {
+                    int32 Lo = 0, Hi = (int32)NumStrings;
+                    while (Lo < Hi)
+                    {
+                        const int32 Mid = Lo + (Hi - Lo) / 2;
+                        const int32 C = Str(Mid).Compare(S, ESearchCase::IgnoreCase);
+                        if (C < 0 || (bUpper && C == 0)) Lo = Mid + 1;
+                        else Hi = Mid;
+                    }
+                    return Lo;
+                };
+            FStringIdRun Run;
+            Run.First = Bound(false);
+            Run.Num = Bound(true) - Run.First;
+            return Run;
+        }
+
+    private:
+        const uint32* Offsets = nullptr;
+        const ANSICHAR* Blob = nullptr;
+        uint32 NumStrings = 0;
+    };
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+
+// Per-Blueprint symbol table (game thread only).
+// Built once per snapshot from a single GetAllGraphs() walk: top-level graphs in GetAllGraphs
+// order, function / event / custom event entries in the order bpmeta.json lists them, and
+// name-hashed lookups for graphs, macros and variables. Lookups use FName and are therefore
+// case-insensitive like the FString comparisons they replace.
+namespace BTD
+{
+    enum class ESymbolKind : uint8
+    {
+        Function,
+        Event,
+        CustomEvent,
+    };
+
+    struct FFunctionSymbol
+    {
+        FName Name;
+        ESymbolKind Kind = ESymbolKind::Function;
+        UEdGraph* Graph = nullptr;  // 선언된 top-level 그래프
+    };
+
+    class FBlueprintSymbols
+    {
+    public:
+        explicit FBlueprintSymbols(UBlueprint* InBP)
+            : BP(InBP)
+        {
+            if (!BP) return;
+
+            TArray<UEdGraph*> All;
+            BP->GetAllGraphs(All);
+            for (UEdGraph* G : All)
+            {
+                if (!IsValid(G) || G->GetOuter() != BP) continue; // top-level만
+                Graphs.Add(G);
+                GraphsByName.FindOrAdd(G->GetFName(), G);
+                AddGraphEntries(G);
+            }
+            for (UEdGraph* G : BP->MacroGraphs)
+            {
+                if (IsValid(G)) MacrosByName.FindOrAdd(G->GetFName(), G);
+            }
+            for (int32 i = 0; i < BP->NewVariables.Num(); ++i)
+            {
+                VariablesByName.FindOrAdd(BP->NewVariables[i].VarName, i);
+            }
+        }
+
+        UBlueprint* GetBlueprint() const { return BP; }
+
+        // top-level 그래프 (GetAllGraphs 순서)
+        const TArray<UEdGraph*>& GetGraphs() const { return Graphs; }
+
+        // 함수 / 이벤트 / 커스텀 이벤트 (종류별 이름 중복 없음, 그래프 → 노드 순서)
+        const TArray<FFunctionSymbol>& GetFunctions() const { return Functions; }
+
+        UEdGraph* FindGraph(FName Name) const
+        {
+            if (Name.IsNone()) return nullptr;
+            UEdGraph* const* Found = GraphsByName.Find(Name);
+            return Found ? *Found : nullptr;
+        }
+
+        UEdGraph* FindMacro(FName Name) const
+        {
+            if (Name.IsNone()) return nullptr;
+            UEdGraph* const* Found = MacrosByName.Find(Name);
+            return Found ? *Found : nullptr;
+        }
+
+        const FFunctionSymbol* FindFunction(FName Name, ESymbolKind Kind) const
+        {
+            const int32* Found = FunctionsByKey.Find(TPair<FName, ESymbolKind>(Name, Kind));
+            return Found ? &Functions[*Found] : nullptr;
+        }
+
+        const FBPVariableDescription* FindVariable(FName Name) const
+        {
+            const int32* Found = VariablesByName.Find(Name);
+            return Found ? &BP->NewVariables[*Found] : nullptr;
+        }
+
+    private:
+        void AddGraphEntries(UEdGraph* G)
+        {
+            for (UEdGraphNode* N : G->Nodes)
+            {
+                if (IsValid(N) && N->IsA<UK2Node_FunctionEntry>())
+                {
+                    AddFunction(G->GetFName(), ESymbolKind::Function, G);
+                    break;
+                }
+            }
+            for (UEdGraphNode* N : G->Nodes)
+            {
+                if (!IsValid(N)) continue;
+                // UK2Node_CustomEvent는 UK2Node_Event 파생이라 먼저 검사
+                if (const UK2Node_CustomEvent* CE = Cast<UK2Node_CustomEvent>(N))
+                {
+                    AddFunction(CE->CustomFunctionName, ESymbolKind::CustomEvent, G);
+                }
+                else if (const UK2Node_Event* Ev = Cast<UK2Node_Event>(N))
+                {
+                    AddFunction(Ev->EventReference.GetMemberName(), ESymbolKind::Event, G);
+                }
+            }
+        }
+
+        void AddFunction(FName Name, ESymbolKind Kind, UEdGraph* G)
+        {
+            if (Name.IsNone()) return;
+            const TPair<FName, ESymbolKind> Key(Name, Kind);
+            if (FunctionsByKey.Contains(Key)) return;
+            FunctionsByKey.Add(Key, Functions.Add({ Name, Kind, G }));
+        }
+
+        UBlueprint* BP = nullptr;
+        TArray<UEdGraph*> Graphs;
+        TArray<FFunctionSymbol> Functions;
+        TMap<FName, UEdGraph*> GraphsByName;
+        TMap<FName, UEdGraph*> MacrosByName;
+        TMap<TPair<FName, ESymbolKind>, int32> FunctionsByKey;
+        TMap<FName, int32> VariablesByName;  // BP->NewVariables 인덱스
+    };
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "Misc/StringBuilder.h"
+
+namespace BTD
+{
+    // UTF-8 byte builder used by every emitter (JSON, NDJSON, DSL, markdown).
+    // Text is encoded straight from TCHAR into Bytes; BOM and CRLF are decided in Reset()
+    // and applied while appending, so the finished buffer goes to disk as-is.
+    // It is also an FArchive so TJsonWriter<UTF8CHAR> can serialize into it directly.
+    class FUtf8Builder : public FArchive
+    {
+    public:
+        TArray<uint8> Bytes;
+
+        FUtf8Builder()
+        {
+            SetIsSaving(true);
+            SetIsPersistent(false);
+        }
+
+        // bInCRLF: '\n', '\r' and "\r\n" are all written as "\r\n"
+        void Reset(bool bInBom = false, bool bInCRLF = false)
+        {
+            Bytes.Reset();
+            bCRLF = bInCRLF;
+            bPrevCR = false;
+            if (bInBom) { Bytes.Add(0xEF); Bytes.Add(0xBB); Bytes.Add(0xBF); }
+        }
+
+        int32 Num() const           { return Bytes.Num(); }
+        const uint8* GetData() const { return Bytes.GetData(); }
+
+        void Append(const TCHAR* S, int32 Len)
+        {
+            if (Len <= 0) return;
+            // 최악의 경우 TCHAR 1개 → 3바이트 (CRLF 2바이트, 서로게이트 쌍 2개 → 4바이트)
+            const int32 Start = Bytes.Num();
+            Bytes.AddUninitialized(Len * 3);
+            uint8* Out = Bytes.GetData() + Start;
+
+            for (int32 i = 0; i < Len; ++i)
+            {
+                uint32 C = (uint32)S[i];
+
+                if (bCRLF && (C == '\r' || C == '\n'))
+                {
+                    const bool bSkip = (C == '\n' && bPrevCR);
+                    bPrevCR = (C == '\r');
+                    if (!bSkip) { *Out++ = '\r'; *Out++ = '\n'; }
+                    continue;
+                }
+                bPrevCR = false;
+
+                if (C < 0x80)
+                {
+                    *Out++ = (uint8)C;
+                    continue;
+                }
+                if (C >= 0xD800 && C <= 0xDFFF)
+                {
+                    const uint32 Lo = (i + 1 < Len) ? (uint32)S[i + 1] : 0;
+                    if (C <= 0xDBFF && Lo >= 0xDC00 && Lo <= 0xDFFF)
+                    {
+                        C = 0x10000 + ((C - 0xD800) << 10) + (Lo - 0xDC00);
+                        ++i;
+                    }
+                    else
+                    {
+                        *Out++ = '?'; // 짝 없는 서로게이트
+                        continue;
+                    }
+                }
+                if (C < 0x800)
+                {
+                    *Out++ = (uint8)(0xC0 | (C >> 6));
+                    *Out++ = (uint8)(0x80 | (C & 0x3F));
+                }
+                else if (C < 0x10000)
+                {
+                    *Out++ = (uint8)(0xE0 | (C >> 12));
+                    *Out++ = (uint8)(0x80 | ((C >> 6) & 0x3F));
+                    *Out++ = (uint8)(0x80 | (C & 0x3F));
+                }
+                else
+                {
+                    *Out++ = (uint8)(0xF0 | (C >> 18));
+                    *Out++ = (uint8)(0x80 | ((C >> 12) & 0x3F));
+                    *Out++ = (uint8)(0x80 | ((C >> 6) & 0x3F));
+                    *Out++ = (uint8)(0x80 | (C & 0x3F));
+                }
+            }
+            Bytes.SetNum((int32)(Out - Bytes.GetData()), EAllowShrinking::No);
+        }
+
+        void Append(const FString& S) { Append(*S, S.Len()); }
+        void Append(FStringView S)    { Append(S.GetData(), S.Len()); }
+        void Append(const TCHAR* S)   { Append(S, FCString::Strlen(S)); }
+
+        FUtf8Builder& operator+=(const FString& S) { Append(S); return *this; }
+        FUtf8Builder& operator+=(const TCHAR* S)   { Append(S); return *this; }
+
+        // JSON 문자열 리터럴 (따옴표 포함). 이스케이프 규칙은 TJsonWriter와 같음
+        void AppendJsonString(FStringView S)
+        {
+            Bytes.Add('"');
+            const TCHAR* P = S.GetData();
+            const TCHAR* End = P + S.Len();
+            while (P < End)
+            {
+                // 이스케이프가 필요 없는 구간은 한 번에 인코딩
+                const TCHAR* Run = P;
+                while (P < End && *P >= 0x20 && *P != '"' && *P != '\\') ++P;
+                Append(Run, int32(P - Run));
+                if (P == End) break;
+
+                switch (*P)
+                {
+                case '"':  AppendAscii("\\\"", 2); break;
+                case '\\': AppendAscii("\\\\", 2); break;
+                case '\b': AppendAscii("\\b", 2); break;
+                case '\f': AppendAscii("\\f", 2); break;
+                case '\n': AppendAscii("\\n", 2); break;
+                case '\r': AppendAscii("\\r", 2); break;
+                case '\t': AppendAscii("\\t", 2); break;
+                default:
+                {
+                    ANSICHAR Hex[8];
+                    FCStringAnsi::Snprintf(Hex, UE_ARRAY_COUNT(Hex), "\\u%04x", uint32(*P));
+                    AppendAscii(Hex, 6);
+                    break;
+                }
+                }
+                ++P;
+            }
+            Bytes.Add('"');
+        }
+
+        // Printf 형식 (짧은 줄 전용, 스택 버퍼에서 포맷 후 인코딩)
+        template <typename FmtType, typename... Types>
+        void Appendf(const FmtType& Fmt, Types... Args)
+        {
+            TStringBuilder<512> SB;
+            SB.Appendf(Fmt, Args...);
+            Append(SB.GetData(), SB.Len());
+        }
+
+        // FArchive: TJsonWriter<UTF8CHAR>가 이미 UTF-8로 만든 바이트 (JSON 안에는 raw 개행 없음)
+        virtual void Serialize(void* Data, int64 Len) override
+        {
+            Bytes.Append(static_cast<const uint8*>(Data), (int32)Len);
+        }
+
+        virtual FString GetArchiveName() const override { return TEXT("BTD::FUtf8Builder"); }
+
+    private:
+        void AppendAscii(const ANSICHAR* S, int32 Len)
+        {
+            Bytes.Append(reinterpret_cast<const uint8*>(S), Len);
+        }
+
+        bool bCRLF = false;
+        bool bPrevCR = false;
+    };
+
+    // Per-thread pool of builders; capacity survives between artifacts.
+    class FScopedUtf8Builder
+    {
+    public:
+        explicit FScopedUtf8Builder(bool bBom = false, bool bCRLF = false)
+        {
+            TArray<TUniquePtr<FUtf8Builder>>& Free = FreeList();
+            if (Free.Num() > 0)
+            {
+                B = MoveTemp(Free.Last());
+                Free.RemoveAt(Free.Num() - 1, 1, EAllowShrinking::No);
+            }
+            else
+            {
+                B = MakeUnique<FUtf8Builder>();
+            }
+            B->Reset(bBom, bCRLF);
+        }
+
+        ~FScopedUtf8Builder()
+        {
+            TArray<TUniquePtr<FUtf8Builder>>& Free = FreeList();
+            if (Free.Num() >= MaxPooled) return;
+            // 유난히 큰 버퍼는 풀에 묶어두지 않음
+            if (B->Bytes.Max() > MaxPooledBytes) B->Bytes.Empty();
+            Free.Add(MoveTemp(B));
+        }
+
+        FUtf8Builder& operator*() const  { return *B; }
+        FUtf8Builder* operator->() const { return B.Get(); }
+
+    private:
+        static constexpr int32 MaxPooled = 4;
+        static constexpr int32 MaxPooledBytes = 16 * 1024 * 1024;
+
+        static TArray<TUniquePtr<FUtf8Builder>>& FreeList()
+        {
+            static thread_local TArray<TUniquePtr<FUtf8Builder>> Free;
+            return Free;
+        }
+
+        TUniquePtr<FUtf8Builder> B;
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BPTextDumpCommandlet.generated.h"
+
+// Headless entry point for batch/CI runs:
+//   UnrealEditor-Cmd <Project>.uproject -run=BPTextDump [Mode=DumpAll|ProjectRefs|All|MergeShards] [Root=/Game] [Out=/path] [Jobs=N] [Prefetch=N] [MemBudgetMB=N] [Shard=i/N] [Store] [Facts] [Force]
+// Same arguments as BP.DumpAll / BP.ProjectRefs. Returns 0 on success, 1 if any asset/artifact failed, 2 on bad arguments.
+UCLASS()
+class UBPTextDumpCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+public:
+    UBPTextDumpCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
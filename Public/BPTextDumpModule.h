@@ -5,17 +5,35 @@
 struct IConsoleCommand; // engine defines this as struct
 class UBlueprint;       // forward declare for function sigs
 
+// Run* 결과 (커맨드렛 종료 코드: Ok = 0, Failed = 1, BadArguments = 2)
+enum class EBPTextDumpResult : uint8
+{
+    Ok,
+    Failed,         // 에셋 로드/산출물 기록 실패 등
+    BadArguments,   // 잘못된 인자 (예: Shard=)
+};
+
 class FBPTextDumpModule : public IModuleInterface
 {
 public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
+    // BP.DumpAll / BP.ProjectRefs / BP.MergeShards 본체 (콘솔 명령과 커맨드렛이 공유)
+    EBPTextDumpResult RunDumpAll(const TArray<FString>& Args);
+    EBPTextDumpResult RunProjectRefs(const TArray<FString>& Args);
+    EBPTextDumpResult RunMergeShards(const TArray<FString>& Args);
+    bool RunQuery(const TArray<FString>& Args);
+    bool RunFacts(const TArray<FString>& Args);
+
 private:
     void CmdDumpAll(const TArray<FString>& Args);
     void CmdDumpSelected(const TArray<FString>& Args);
     void CmdDumpOne(const TArray<FString>& Args);
     void CmdProjectRefs(const TArray<FString>& Args);
+    void CmdMergeShards(const TArray<FString>& Args);
+    void CmdQuery(const TArray<FString>& Args);
+    void CmdFacts(const TArray<FString>& Args);
     void UI_BuildProjectRefs();
     void UI_DumpAll();
     void UI_DumpSelected();
@@ -27,4 +45,7 @@ private:
     IConsoleCommand* DumpSelCmd = nullptr;
     IConsoleCommand* DumpOneCmd = nullptr;
     IConsoleCommand* ProjectRefsCmd = nullptr;
+    IConsoleCommand* MergeShardsCmd = nullptr;
+    IConsoleCommand* QueryCmd = nullptr;
+    IConsoleCommand* FactsCmd = nullptr;
 };
\ No newline at end of file
@@ -13,4 +13,12 @@ public:
 
     UPROPERTY(EditAnywhere, config, Category = "Defaults", meta = (ToolTip = "Empty = Saved/BPTextDump"))
     FString DefaultOutDir;
+
+    // BP.DumpAll / BP.DumpSelected / BP.ProjectRefs: number of packages loaded asynchronously ahead of the one being dumped
+    UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = "0", ClampMax = "128", ToolTip = "0 = load each Blueprint synchronously. Override per run with Prefetch=N"))
+    int32 PrefetchWindow = 8;
+
+    // Also write <BP>.bpfacts.bin (interned string table + s/p/o columns) next to bpfacts.ndjson for bulk consumers
+    UPROPERTY(EditAnywhere, config, Category = "Output")
+    bool bWriteBinaryFacts = false;
 };